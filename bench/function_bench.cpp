@@ -0,0 +1,142 @@
+//
+// Node callable storage: InplaceFunction vs std::function
+//
+// Usage:
+//   function_bench [nodes] [rounds]
+//
+// Reports, for an operator-shaped callable (a lambda capturing two
+// shared_ptrs), the bytes each storage costs and the latency of calling it,
+// then the allocation footprint and recompute latency of real derived nodes.
+//
+
+#include "ZongHeng.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <vector>
+
+using namespace ZongHeng;
+
+// ============================================================================
+// Allocation counter
+// ============================================================================
+
+namespace {
+size_t gAllocations = 0;
+size_t gBytes       = 0;
+} // namespace
+
+void* operator new(size_t size) {
+    ++gAllocations;
+    gBytes += size;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+struct Usage {
+    size_t allocations;
+    size_t bytes;
+};
+
+Usage usage() {
+    return { gAllocations, gBytes };
+}
+
+double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ============================================================================
+// Callable storage
+// ============================================================================
+
+template<class Function>
+void callables(const char* label, size_t count, long rounds) {
+    auto p = std::make_shared<long>(1);
+    auto q = std::make_shared<long>(2);
+
+    std::vector<Function> fns;
+    fns.reserve(count);
+    auto reserved = usage();
+    for (size_t i = 0; i < count; ++i) {
+        fns.emplace_back([p, q]() { return *p + *q; });
+    }
+    auto after = usage();
+
+    long sink  = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long r = 0; r < rounds; ++r) {
+        for (auto& fn : fns) {
+            sink += fn();
+        }
+    }
+    auto elapsed = seconds(start);
+    auto calls   = static_cast<double>(rounds) * count;
+
+    std::printf("%-16s %3zu B inline + %5.1f B heap (%zu allocs), %6.2f ns/call [%ld]\n",
+                label, sizeof(Function),
+                static_cast<double>(after.bytes - reserved.bytes) / count,
+                after.allocations - reserved.allocations,
+                elapsed * 1e9 / calls, sink);
+}
+
+// ============================================================================
+// Derived nodes
+// ============================================================================
+
+void nodes(size_t count, long rounds) {
+    auto a = Qin<long>::make(1);
+    auto b = Qin<long>::make(2);
+
+    std::vector<std::shared_ptr<Qin<long>>> derived;
+    derived.reserve(count);
+
+    auto before = usage();
+    for (size_t i = 0; i < count; ++i) {
+        derived.push_back(a + b); // cold: recomputed on every get() after a write
+    }
+    auto after = usage();
+
+    long sink  = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long r = 0; r < rounds; ++r) {
+        *a = r;
+        for (auto& node : derived) {
+            sink += node->get();
+        }
+    }
+    auto elapsed = seconds(start);
+    auto reads   = static_cast<double>(rounds) * count;
+
+    std::printf("%-16s %3zu B object, %7.1f B heap/node (%.1f allocs/node), %6.2f ns/recompute [%ld]\n",
+                "Qin<long> a + b", sizeof(Yi<long, long>),
+                static_cast<double>(after.bytes - before.bytes) / count,
+                static_cast<double>(after.allocations - before.allocations) / count,
+                elapsed * 1e9 / reads, sink);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count  = argc >= 2 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    long   rounds = argc >= 3 ? std::atol(argv[2]) : 100;
+
+    callables<std::function<long()>>("std::function", count, rounds);
+    callables<InplaceFunction<long()>>("InplaceFunction", count, rounds);
+    nodes(count, rounds);
+    return 0;
+}
@@ -0,0 +1,68 @@
+//
+// Read and write latency of Qin<int> accessors
+//
+// Usage:
+//   get_bench [reads]
+//
+// Reports ns per get() of a source node, a clean derived node and a node
+// with a getter, and ns per set() of a source node with one derived node.
+//
+
+#include "ZongHeng.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace ZongHeng;
+
+namespace {
+
+double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<class Node>
+void reads(const char* label, Node& node, long count) {
+    long sink  = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < count; ++i) {
+        sink += node->get();
+    }
+    auto elapsed = seconds(start);
+
+    std::printf("%-20s %6.2f ns/get [%ld]\n", label, elapsed * 1e9 / count, sink);
+}
+
+void writes(long count) {
+    auto source  = Qin<int>::make(0);
+    auto derived = source + source;
+    auto watch   = derived->observe();
+
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < count; ++i) {
+        *source = static_cast<int>(i);
+    }
+    auto elapsed = seconds(start);
+
+    std::printf("%-20s %6.2f ns/set [%d]\n", "set (1 hot derived)", elapsed * 1e9 / count, derived->get());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long count = argc >= 2 ? std::atol(argv[1]) : 50000000;
+
+    auto source = Qin<int>::make(1);
+    reads("source", source, count);
+
+    auto derived = source * source;
+    derived->get();
+    reads("clean derived", derived, count);
+
+    auto hooked = Qin<int>::make(2);
+    hooked->getter([](const int& v) { return v * 3; });
+    reads("getter", hooked, count);
+
+    writes(count / 10);
+    return 0;
+}
@@ -0,0 +1,103 @@
+//
+// Epoch throughput of a ShardedGraph from 1 to 16 shards
+//
+// Usage:
+//   shard_bench [components] [epochs] [work]
+//
+// Builds `components` independent chains (a source, four maps spinning
+// `work` iterations each, and their sum), all observed. Every epoch writes
+// every source and runs the graph. Reports epochs/s unsharded and with
+// 1, 2, 4, 8 and 16 shards; speedup is bounded by the number of cores.
+//
+
+#include "ZongHeng.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace ZongHeng;
+
+namespace {
+
+using Node = std::shared_ptr<Qin<long>>;
+
+struct Graph {
+    std::vector<Node>                     sources;
+    std::vector<QinBase::SharedQinBase_T> roots;
+    std::vector<QinBase::Observation>     watches;
+};
+
+double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+Graph build(int components, long work) {
+    Graph graph;
+    for (int c = 0; c < components; ++c) {
+        auto source = Qin<long>::make(c);
+        Node sum;
+        for (long k = 1; k <= 4; ++k) {
+            auto spin = source->map([work, k](long v) {
+                long acc = v;
+                for (long i = 0; i < work; ++i) {
+                    acc = acc * 6364136223846793005L + k;
+                }
+                return acc;
+            });
+            sum = sum ? sum + spin : spin;
+        }
+        graph.sources.push_back(source);
+        graph.roots.push_back(sum);
+        graph.watches.push_back(sum->observe());
+    }
+    return graph;
+}
+
+void report(const char* label, double elapsed, long epochs, double base) {
+    double rate = epochs / elapsed;
+    std::printf("%-12s %10.0f epochs/s  x%.2f\n", label, rate, base > 0 ? rate / base : 1.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int  components = argc >= 2 ? std::atoi(argv[1]) : 256;
+    long epochs     = argc >= 3 ? std::atol(argv[2]) : 200;
+    long work       = argc >= 4 ? std::atol(argv[3]) : 2000;
+
+    double base = 0;
+    {
+        auto graph = build(components, work);
+        auto start = std::chrono::steady_clock::now();
+        for (long e = 0; e < epochs; ++e) {
+            Batch batch;
+            for (auto& source : graph.sources) {
+                *source = source->get() + 1;
+            }
+        }
+        auto elapsed = seconds(start);
+        base         = epochs / elapsed;
+        report("unsharded", elapsed, epochs, 0);
+    }
+
+    for (uint32_t shards : { 1u, 2u, 4u, 8u, 16u }) {
+        auto graph   = build(components, work);
+        auto sharded = shard(graph.roots, { shards });
+
+        auto start = std::chrono::steady_clock::now();
+        for (long e = 0; e < epochs; ++e) {
+            for (auto& source : graph.sources) {
+                *source = source->peek() + 1;
+            }
+            sharded->run();
+        }
+        auto elapsed = seconds(start);
+
+        char label[32];
+        std::snprintf(label, sizeof(label), "%u shard%s", shards, shards == 1 ? "" : "s");
+        report(label, elapsed, epochs, base);
+    }
+
+    return 0;
+}
@@ -9,13 +9,134 @@ void operator<<(std::shared_ptr<QinBase> l, std::shared_ptr<QinBase> r) {
 }
 
 void QinBase::bind(const std::shared_ptr<QinBase>& src) {
-    auto& src_zong = src->Zong;
-    if (std::find_if(src_zong.begin(), src_zong.end(), [this](const std::shared_ptr<QinBase>& t) {
-            return t.get() == this;
-        })
-        != src_zong.end()) {
+    for (auto& source : Sources) {
+        if (source.node == src.get()) {
+            return;
+        }
+    }
+
+    src->Zong.push_back(self);
+    Sources.push_back({ src.get(), static_cast<uint32_t>(src->Zong.size() - 1) });
+
+    // A bound node mirrors every write, so the source has to stay hot
+    src->retain();
+}
+
+void QinBase::unlink(const std::shared_ptr<QinBase>& src) {
+    ZongHeng::Batch::defer([node = self, src]() {
+        node->unbind(src.get());
+    });
+}
+
+void QinBase::unbind(QinBase* src) {
+    auto source = std::find_if(Sources.begin(), Sources.end(), [src](const Slot& slot) {
+        return slot.node == src;
+    });
+    if (source == Sources.end()) {
+        return;
+    }
+
+    // Zong order does not matter: the last binding takes the freed position
+    auto  keep  = self;
+    auto& zongs = src->Zong;
+    auto  at    = locate(zongs, Sources, src, this);
+    Sources.erase(source);
+    if (at != zongs.size()) {
+        if (at + 1 != zongs.size()) {
+            zongs[at] = std::move(zongs.back());
+            for (auto& slot : zongs[at]->Sources) {
+                if (slot.node == src) {
+                    slot.index = static_cast<uint32_t>(at);
+                }
+            }
+        }
+        zongs.pop_back();
+    }
+
+    unbound(*src);
+    src->release();
+}
+
+void QinBase::dispose() {
+    if (frozen) {
+        throw std::runtime_error("Cannot dispose a node held by a FrozenGraph or ShardedGraph");
+    }
+
+    ZongHeng::Batch::defer([node = self]() {
+        if (node->disposed) {
+            return;
+        }
+        node->retire();
+        node->disposed = true;
+        node->rewires  = false;
+        node->recipe   = 0;
+        node->Operands.clear();
+        if (!node->isConstant()) {
+            node->kind = ZongHeng::NodeKind::Source; // snapshots save its value
+        }
+
+        while (!node->Zong.empty()) {
+            node->Zong.back()->unbind(node.get());
+        }
+        while (!node->Sources.empty()) {
+            node->unbind(node->Sources.back().node);
+        }
+
+        for (auto* up : node->Upstream) {
+            node->dropHeng(up); // constant operands have no Heng edge
+            if (node->isHot()) {
+                up->release();
+            }
+        }
+        node->Upstream.clear();
+        node->HengSlots.clear();
+    });
+}
+
+bool QinBase::dropHeng(QinBase* upstream) {
+    auto& hengs = upstream->Heng;
+    auto  at    = locate(hengs, HengSlots, upstream, this);
+    if (at == hengs.size()) {
+        return false;
+    }
+
+    hengs[at].reset();
+    auto slot = std::find_if(HengSlots.begin(), HengSlots.end(), [upstream](const Slot& s) {
+        return s.node == upstream;
+    });
+    if (slot != HengSlots.end()) {
+        HengSlots.erase(slot);
+    }
+
+    // Compact once half the list is empty (queued once per crossing)
+    auto dead = ++upstream->deadHeng;
+    if (dead * 2 > hengs.size() && (dead - 1) * 2 <= hengs.size()) {
+        ZongHeng::Batch::defer([up = upstream->self]() {
+            up->compactHeng();
+        });
+    }
+    return true;
+}
+
+void QinBase::compactHeng() {
+    if (deadHeng == 0) {
         return;
     }
 
-    src_zong.push_back(self);
+    Heng.erase(std::remove(Heng.begin(), Heng.end(), nullptr), Heng.end());
+    deadHeng = 0;
+    reslotHeng();
+}
+
+void QinBase::reslotHeng() {
+    for (size_t i = 0; i < Heng.size(); ++i) {
+        if (!Heng[i]) {
+            continue;
+        }
+        for (auto& slot : Heng[i]->HengSlots) {
+            if (slot.node == this) {
+                slot.index = static_cast<uint32_t>(i);
+            }
+        }
+    }
 }
@@ -10,14 +10,35 @@
 
 // Core components
 #include "core/ZongHengBase.h"
+#include "core/InplaceFunction.h"
+#include "core/ExprTable.h"
+#include "core/Clock.h"
+#include "core/TimerWheel.h"
+#include "core/RingBuffer.h"
+#include "core/SpscRing.h"
+#include "core/Subscription.h"
+#include "core/Ingest.h"
+#include "core/Serializer.h"
 
 // Node types
 #include "nodes/Yi.h"
 #include "nodes/Qin.h"
+#include "nodes/Temporal.h"
+#include "nodes/Window.h"
+#include "nodes/Map.h"
+#include "nodes/Computed.h"
+#include "nodes/Count.h"
 
 // Operations
 #include "operations/Operators.h"
 #include "operations/Combinators.h"
+#include "operations/Freeze.h"
+#include "operations/Shard.h"
+
+// Persistence
+#include "io/Snapshot.h"
+#include "io/Checkpoint.h"
+#include "io/Journal.h"
 
 // Utilities
 #include "QinUtils.h"
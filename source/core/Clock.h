@@ -0,0 +1,73 @@
+//
+// Clock - Pluggable time source for time-based operators
+//
+
+#ifndef ZONGHENG_CORE_CLOCK_H
+#define ZONGHENG_CORE_CLOCK_H
+
+#include <chrono>
+#include <memory>
+
+namespace ZongHeng {
+
+// ============================================================================
+// Clock - Abstract time source
+// ============================================================================
+
+/**
+ * @brief Monotonic time source used by throttle/debounce and the timer wheel
+ *
+ * Production code uses SteadyClock; tests inject a ManualClock so time only
+ * moves when the test says so.
+ */
+class Clock {
+public:
+    using duration   = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<std::chrono::steady_clock, duration>;
+
+    virtual ~Clock() = default;
+
+    virtual time_point now() const = 0;
+};
+
+// ============================================================================
+// SteadyClock - std::chrono::steady_clock backed time source
+// ============================================================================
+
+class SteadyClock : public Clock {
+public:
+    time_point now() const override {
+        return std::chrono::time_point_cast<duration>(std::chrono::steady_clock::now());
+    }
+};
+
+// ============================================================================
+// ManualClock - Fake clock that only advances on request
+// ============================================================================
+
+/**
+ * @brief Deterministic clock for tests
+ *
+ * @example
+ * auto clock = std::make_shared<ManualClock>();
+ * clock->advance(std::chrono::milliseconds(10));
+ */
+class ManualClock : public Clock {
+    time_point current {};
+
+public:
+    ManualClock() = default;
+
+    explicit ManualClock(time_point start)
+        : current(start) { }
+
+    time_point now() const override { return current; }
+
+    void advance(duration d) { current += d; }
+
+    void set(time_point t) { current = t; }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_CORE_CLOCK_H
@@ -0,0 +1,128 @@
+//
+// ExprTable - Hash-consing of built-in operator nodes
+//
+
+#ifndef ZONGHENG_CORE_EXPR_TABLE_H
+#define ZONGHENG_CORE_EXPR_TABLE_H
+
+#include "ZongHengBase.h"
+#include <unordered_map>
+
+namespace ZongHeng {
+
+// ============================================================================
+// ExprTable - (operator kind, operand ids) -> existing node
+// ============================================================================
+
+/**
+ * @brief Shares structurally identical operator nodes
+ *
+ * When enabled, every built-in arithmetic, bitwise, comparison and unary
+ * operator first looks up (kind, lhs id, rhs id). If a live node was
+ * already built from the same operator and operands it is returned instead
+ * of a new one, so repeated sub-expressions (`a + b` in many formulas)
+ * become one node that is recomputed once. Operands of commutative
+ * operators are ordered by id, so `b + a` also finds `a + b`.
+ *
+ * Off by default: a shared node is the same object for every caller, so
+ * hooks, getters or writes made on it through one handle are seen by all.
+ * Entries are non-owning; expired or disposed ones are replaced on the
+ * next miss.
+ * Like NodeRegistry, the table is not synchronized.
+ *
+ * @example
+ * auto& exprs = ZongHeng::ExprTable::global();
+ * exprs.enable();
+ * auto x = a + b;
+ * auto y = b + a;               // same node as x
+ * exprs.getStats().hits;        // 1
+ */
+class ExprTable {
+public:
+    struct Stats {
+        size_t lookups = 0; // Operator nodes requested while enabled
+        size_t hits    = 0; // Requests answered with an existing node
+        size_t entries = 0; // Table size (including expired entries)
+    };
+
+private:
+    struct Key {
+        NodeKind kind;
+        uint32_t lhs;
+        uint32_t rhs;
+
+        bool operator==(const Key& other) const {
+            return kind == other.kind && lhs == other.lhs && rhs == other.rhs;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            uint64_t packed = (static_cast<uint64_t>(key.lhs) << 32) | key.rhs;
+            return std::hash<uint64_t>()(packed * 31 + static_cast<uint8_t>(key.kind));
+        }
+    };
+
+    std::unordered_map<Key, std::weak_ptr<QinBase>, KeyHash> table;
+
+    bool   enabled = false;
+    size_t lookups = 0;
+    size_t hits    = 0;
+
+public:
+    static ExprTable& global() {
+        static auto* exprs = new ExprTable; // Outlives nodes destroyed at exit
+        return *exprs;
+    }
+
+    void enable(bool on = true) { enabled = on; }
+    void disable() { enabled = false; }
+    bool isEnabled() const { return enabled; }
+
+    // Forget every entry and reset the counters (nodes are not affected)
+    void clear() {
+        table.clear();
+        lookups = 0;
+        hits    = 0;
+    }
+
+    Stats getStats() const {
+        return { lookups, hits, table.size() };
+    }
+
+    /**
+     * @brief Existing node for (kind, lhs, rhs), or the one make() builds
+     * @param kind Operator producing the node
+     * @param lhs Left (or only) operand
+     * @param rhs Right operand (lhs again for unary operators)
+     * @param commutative Whether lhs and rhs may be swapped
+     * @param make Builds the node on a miss
+     * @return Node holding Qin<R>
+     */
+    template<class R, class Make>
+    std::shared_ptr<Qin<R>> intern(NodeKind kind, const QinBase& lhs, const QinBase& rhs, bool commutative, Make make) {
+        if (!enabled) {
+            return make();
+        }
+
+        ++lookups;
+        Key key { kind, lhs.getId(), rhs.getId() };
+        if (commutative && key.rhs < key.lhs) {
+            std::swap(key.lhs, key.rhs);
+        }
+
+        auto& entry = table[key];
+        if (auto found = entry.lock(); found && !found->isDisposed()) {
+            ++hits;
+            return std::static_pointer_cast<Qin<R>>(found);
+        }
+
+        auto node = make();
+        entry     = node;
+        return node;
+    }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_CORE_EXPR_TABLE_H
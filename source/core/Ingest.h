@@ -0,0 +1,175 @@
+//
+// Ingest - Source writes posted from other threads, applied by the graph thread
+//
+
+#ifndef ZONGHENG_CORE_INGEST_H
+#define ZONGHENG_CORE_INGEST_H
+
+#include "Subscription.h"
+#include <atomic>
+#include <functional>
+
+namespace ZongHeng {
+
+// ============================================================================
+// Ingest - Lock-free multi-producer queue of pending source writes
+// ============================================================================
+
+/**
+ * @brief Carries Yi::post() writes from producer threads to the graph thread
+ *
+ * Every node that is posted to gets a Mailbox holding its latest pending
+ * value. post() swaps the new value into the mailbox and, if the mailbox is
+ * not queued yet, pushes it on a lock-free stack: producers never take a
+ * lock or wait for the graph. A value posted before the previous one was
+ * applied replaces it, so a burst of writes to one source costs one set().
+ *
+ * drain() runs on the thread that owns the graph. It takes every queued
+ * mailbox (in order of their first post) and applies each latest value
+ * inside one Batch, so subscribers see one notification per drain.
+ * onPending() lets a producer wake that thread when the queue fills.
+ *
+ * @example
+ * // producer threads
+ * price->post(quote.price);
+ * // graph thread
+ * ZongHeng::Ingest::global().drain();
+ */
+class Ingest {
+public:
+    // Pending write of one node; value boxes are allocated by Yi::post
+    struct Mailbox {
+        QinBase* node; // nullptr once the node is destroyed
+        void (*apply)(QinBase&, void*);
+        void (*discard)(void*);
+
+        std::atomic<void*> pending { nullptr }; // Latest posted value (owned)
+        std::atomic<bool>  linked { false };    // Queued for the next drain
+        Mailbox*           next = nullptr;      // Queue link
+
+        Mailbox(QinBase* node, void (*apply)(QinBase&, void*), void (*discard)(void*))
+            : node(node)
+            , apply(apply)
+            , discard(discard) { }
+    };
+
+    struct Stats {
+        size_t drains  = 0; // drain() calls that applied at least one write
+        size_t applied = 0; // Values written to nodes
+    };
+
+private:
+    std::atomic<Mailbox*> queued { nullptr };
+    std::function<void()> wake;
+
+    size_t drains  = 0;
+    size_t applied = 0;
+
+public:
+    static Ingest& global() {
+        static auto* ingest = new Ingest; // Outlives nodes destroyed at exit
+        return *ingest;
+    }
+
+    /**
+     * @brief Call wake from the posting thread when the queue turns non-empty
+     *
+     * Set it before producers start; it must be safe to call from any thread
+     * (e.g. notify a condition variable or write to an eventfd).
+     */
+    void onPending(std::function<void()> fn) { wake = std::move(fn); }
+
+    bool hasPending() const { return queued.load(std::memory_order_acquire) != nullptr; }
+
+    Stats getStats() const { return { drains, applied }; }
+
+    // Any thread: make value the next write of box's node
+    void post(Mailbox& box, void* value) {
+        if (auto* old = box.pending.exchange(value, std::memory_order_acq_rel)) {
+            box.discard(old); // not applied yet: superseded
+        }
+        if (box.linked.exchange(true, std::memory_order_acq_rel)) {
+            return; // the queued mailbox carries the new value
+        }
+
+        // box.next belongs to the graph thread once box is published
+        auto* head = queued.load(std::memory_order_relaxed);
+        do {
+            box.next = head;
+        } while (!queued.compare_exchange_weak(head, &box, std::memory_order_release,
+                                               std::memory_order_relaxed));
+        if (!head && wake) {
+            wake();
+        }
+    }
+
+    /**
+     * @brief Apply the latest posted value of every queued node
+     *
+     * Only call from the thread that owns the graph.
+     *
+     * @return Number of values written
+     */
+    size_t drain() {
+        Mailbox* list = queued.exchange(nullptr, std::memory_order_acquire);
+        if (!list) {
+            return 0;
+        }
+
+        // The stack is LIFO; apply in order of first post
+        Mailbox* ordered = nullptr;
+        while (list) {
+            auto* next = list->next;
+            list->next = ordered;
+            ordered    = list;
+            list       = next;
+        }
+
+        size_t count = 0;
+        Batch  batch; // one propagation pass for the whole drain
+        while (ordered) {
+            auto* box = ordered;
+            ordered   = box->next; // read before a producer can queue box again
+
+            if (!box->node) {
+                if (auto* value = box->pending.exchange(nullptr, std::memory_order_acquire)) {
+                    box->discard(value);
+                }
+                delete box;
+                continue;
+            }
+
+            box->linked.store(false, std::memory_order_release);
+            auto* value = box->pending.exchange(nullptr, std::memory_order_acquire);
+            if (!value) {
+                continue; // taken by an earlier drain after being queued again
+            }
+            try {
+                box->apply(*box->node, value);
+                ++count;
+            } catch (const std::runtime_error&) {
+                // Skip nodes that reject the value, like a bound set()
+            }
+        }
+
+        applied += count;
+        drains  += count > 0;
+        return count;
+    }
+
+    // Graph thread, when the node goes away: a queued mailbox is freed by drain()
+    static void release(Mailbox* box) {
+        box->node = nullptr;
+        if (box->linked.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (auto* value = box->pending.exchange(nullptr, std::memory_order_acquire)) {
+            box->discard(value);
+        }
+        delete box;
+    }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_CORE_INGEST_H
@@ -0,0 +1,218 @@
+//
+// InplaceFunction - Fixed-capacity, non-allocating std::function replacement
+//
+
+#ifndef ZONGHENG_CORE_INPLACE_FUNCTION_H
+#define ZONGHENG_CORE_INPLACE_FUNCTION_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Inline bytes reserved for a node callable; two shared_ptr captures plus a
+// small functor fit in the default. Override before including ZongHeng.h.
+#ifndef ZONGHENG_INPLACE_CAPACITY
+#define ZONGHENG_INPLACE_CAPACITY 48
+#endif
+
+namespace ZongHeng {
+
+template<class Sig, size_t Capacity = ZONGHENG_INPLACE_CAPACITY>
+class InplaceFunction;
+
+// ============================================================================
+// InplaceFunction - Callable stored inside the object
+// ============================================================================
+
+/**
+ * @brief Type-erased callable with inline storage and no heap allocation
+ *
+ * Drop-in for std::function in node members: the callable is constructed
+ * in a buffer of `Capacity` bytes, and a call is a single indirect jump to
+ * a per-type thunk (no manager dispatch). Callables that do not fit are
+ * rejected at compile time; pass them through fitInline(), capture a
+ * std::shared_ptr to the state, or raise the capacity.
+ *
+ * Calling an empty InplaceFunction throws std::bad_function_call.
+ *
+ * @example
+ * ZongHeng::InplaceFunction<int()> f = [a, b]() { return a->get() + b->get(); };
+ */
+template<class R, class... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> {
+    enum class Op { Copy, Move, Destroy };
+
+    using Invoke = R (*)(void*, Args&&...);
+    using Manage = void (*)(Op, void* dst, void* src);
+
+    alignas(std::max_align_t) unsigned char storage[Capacity];
+
+    Invoke invoke = &empty;
+    Manage manage = nullptr;
+
+    [[noreturn]] static R empty(void*, Args&&...) {
+        throw std::bad_function_call();
+    }
+
+    template<class F>
+    static R call(void* self, Args&&... args) {
+        return (*static_cast<F*>(self))(std::forward<Args>(args)...);
+    }
+
+    template<class F>
+    static void handle(Op op, void* dst, void* src) {
+        switch (op) {
+        case Op::Copy:
+            ::new (dst) F(*static_cast<const F*>(src));
+            break;
+        case Op::Move:
+            ::new (dst) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+            break;
+        case Op::Destroy:
+            static_cast<F*>(dst)->~F();
+            break;
+        }
+    }
+
+    template<class F>
+    static bool isNull(const F& f) {
+        if constexpr (std::is_pointer_v<F> || std::is_member_pointer_v<F>) {
+            return f == nullptr;
+        } else {
+            return false;
+        }
+    }
+
+public:
+    static constexpr size_t capacity = Capacity;
+
+    /**
+     * @brief Whether a callable of type F is stored inline by this instantiation
+     */
+    template<class F>
+    static constexpr bool fits = sizeof(F) <= Capacity
+                              && alignof(F) <= alignof(std::max_align_t);
+
+    InplaceFunction() noexcept = default;
+
+    InplaceFunction(std::nullptr_t) noexcept { }
+
+    template<class F, class D = std::decay_t<F>,
+             class = std::enable_if_t<!std::is_same_v<D, InplaceFunction>
+                                      && std::is_invocable_r_v<R, D&, Args...>>>
+    InplaceFunction(F&& f) {
+        static_assert(sizeof(D) <= Capacity,
+                      "Callable too large for InplaceFunction; capture a shared_ptr or raise the capacity");
+        static_assert(alignof(D) <= alignof(std::max_align_t),
+                      "Callable over-aligned for InplaceFunction");
+
+        if (isNull(f)) {
+            return;
+        }
+        ::new (static_cast<void*>(storage)) D(std::forward<F>(f));
+        invoke = &call<D>;
+        manage = &handle<D>;
+    }
+
+    InplaceFunction(const InplaceFunction& other)
+        : invoke(other.invoke)
+        , manage(other.manage) {
+        if (manage) {
+            manage(Op::Copy, storage, const_cast<unsigned char*>(other.storage));
+        }
+    }
+
+    InplaceFunction(InplaceFunction&& other)
+        : invoke(other.invoke)
+        , manage(other.manage) {
+        if (manage) {
+            manage(Op::Move, storage, other.storage);
+            other.invoke = &empty;
+            other.manage = nullptr;
+        }
+    }
+
+    InplaceFunction& operator=(const InplaceFunction& other) {
+        if (this != &other) {
+            InplaceFunction tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) {
+        if (this != &other) {
+            reset();
+            if (other.manage) {
+                other.manage(Op::Move, storage, other.storage);
+                invoke       = other.invoke;
+                manage       = other.manage;
+                other.invoke = &empty;
+                other.manage = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    template<class F, class D = std::decay_t<F>,
+             class = std::enable_if_t<!std::is_same_v<D, InplaceFunction>
+                                      && std::is_invocable_r_v<R, D&, Args...>>>
+    InplaceFunction& operator=(F&& f) {
+        return *this = InplaceFunction(std::forward<F>(f));
+    }
+
+    ~InplaceFunction() {
+        reset();
+    }
+
+    R operator()(Args... args) const {
+        return invoke(const_cast<unsigned char*>(storage), std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept {
+        return manage != nullptr;
+    }
+
+private:
+    void reset() noexcept {
+        if (manage) {
+            manage(Op::Destroy, storage, nullptr);
+            invoke = &empty;
+            manage = nullptr;
+        }
+    }
+};
+
+/**
+ * @brief Adapt a callable so it fits an InplaceFunction of the given capacity
+ *
+ * Callables that fit are returned unchanged. Larger ones are moved into a
+ * std::shared_ptr once, and only that pointer is stored inline; this is the
+ * single allocation nodes pay, and only for oversized captures.
+ *
+ * @example node->setEff(ZongHeng::fitInline([big, state]() { ... }));
+ */
+template<size_t Capacity = ZONGHENG_INPLACE_CAPACITY, class F>
+auto fitInline(F&& f) {
+    using D = std::decay_t<F>;
+    if constexpr (sizeof(D) <= Capacity && alignof(D) <= alignof(std::max_align_t)) {
+        return D(std::forward<F>(f));
+    } else {
+        return [box = std::make_shared<D>(std::forward<F>(f))](auto&&... args) -> decltype(auto) {
+            return (*box)(std::forward<decltype(args)>(args)...);
+        };
+    }
+}
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_CORE_INPLACE_FUNCTION_H
@@ -0,0 +1,189 @@
+//
+// RingBuffer / RollingWindow - Fixed storage for streaming aggregations
+//
+
+#ifndef ZONGHENG_CORE_RING_BUFFER_H
+#define ZONGHENG_CORE_RING_BUFFER_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ZongHeng {
+
+// ============================================================================
+// RingBuffer - Circular FIFO with deque-style access at both ends
+// ============================================================================
+
+/**
+ * @brief Circular buffer over a single allocation
+ *
+ * Storage is allocated once at construction. A push into a full buffer
+ * doubles the capacity (only time-bounded windows ever hit this path;
+ * count-bounded windows pop before they push).
+ */
+template<class T>
+class RingBuffer {
+    std::vector<T> data;
+    size_t         head  = 0;
+    size_t         count = 0;
+
+    size_t wrap(size_t i) const { return i < data.size() ? i : i - data.size(); }
+
+    void grow() {
+        std::vector<T> bigger(data.empty() ? 1 : data.size() * 2);
+        for (size_t i = 0; i < count; ++i) {
+            bigger[i] = std::move(data[wrap(head + i)]);
+        }
+        data = std::move(bigger);
+        head = 0;
+    }
+
+public:
+    explicit RingBuffer(size_t capacity = 0)
+        : data(capacity) { }
+
+    void push_back(T v) {
+        if (count == data.size()) {
+            grow();
+        }
+        data[wrap(head + count)] = std::move(v);
+        ++count;
+    }
+
+    void pop_front() {
+        head = wrap(head + 1);
+        --count;
+    }
+
+    void pop_back() { --count; }
+
+    T&       front() { return data[head]; }
+    const T& front() const { return data[head]; }
+    T&       back() { return data[wrap(head + count - 1)]; }
+    const T& back() const { return data[wrap(head + count - 1)]; }
+
+    const T& operator[](size_t i) const { return data[wrap(head + i)]; }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return data.size(); }
+    bool   empty() const { return count == 0; }
+    bool   full() const { return count == data.size(); }
+
+    void clear() {
+        head  = 0;
+        count = 0;
+    }
+};
+
+// ============================================================================
+// WindowStats - Snapshot of a rolling window
+// ============================================================================
+
+template<class T>
+struct WindowStats {
+    size_t count    = 0;
+    T      sum      = T {};
+    double mean     = 0.0;
+    double variance = 0.0; // population variance
+    T      min      = T {};
+    T      max      = T {};
+};
+
+// ============================================================================
+// RollingWindow - O(1) amortized sum/mean/variance/min/max
+// ============================================================================
+
+/**
+ * @brief Sliding window aggregate
+ *
+ * sum is kept as a running total, mean/variance with Welford's update and
+ * its inverse on eviction, and min/max with monotonic deques, so push() and
+ * pop() are O(1) amortized no matter how large the window is.
+ */
+template<class T>
+class RollingWindow {
+    struct Entry {
+        std::uint64_t seq;
+        T             value;
+    };
+
+    RingBuffer<T>     values;
+    RingBuffer<Entry> minQ; // increasing values
+    RingBuffer<Entry> maxQ; // decreasing values
+    std::uint64_t     headSeq = 0;
+    std::uint64_t     nextSeq = 0;
+    T                 sum {};
+    double            mean = 0.0;
+    double            m2   = 0.0;
+
+public:
+    explicit RollingWindow(size_t capacity)
+        : values(capacity)
+        , minQ(capacity)
+        , maxQ(capacity) { }
+
+    void push(const T& v) {
+        values.push_back(v);
+        sum += v;
+
+        auto n     = static_cast<double>(values.size());
+        auto x     = static_cast<double>(v);
+        auto delta = x - mean;
+        mean += delta / n;
+        m2 += delta * (x - mean);
+
+        while (!minQ.empty() && !(minQ.back().value < v)) minQ.pop_back();
+        while (!maxQ.empty() && !(v < maxQ.back().value)) maxQ.pop_back();
+        minQ.push_back({ nextSeq, v });
+        maxQ.push_back({ nextSeq, v });
+        ++nextSeq;
+    }
+
+    // Evict the oldest sample
+    void pop() {
+        const T v = values.front();
+        values.pop_front();
+        sum -= v;
+
+        if (values.empty()) {
+            mean = 0.0;
+            m2   = 0.0;
+        } else {
+            auto n     = static_cast<double>(values.size());
+            auto x     = static_cast<double>(v);
+            auto delta = x - mean;
+            mean -= delta / n;
+            m2 -= delta * (x - mean);
+            if (m2 < 0.0) {
+                m2 = 0.0; // rounding residue
+            }
+        }
+
+        if (minQ.front().seq == headSeq) minQ.pop_front();
+        if (maxQ.front().seq == headSeq) maxQ.pop_front();
+        ++headSeq;
+    }
+
+    size_t   size() const { return values.size(); }
+    bool     empty() const { return values.empty(); }
+    const T& oldest() const { return values.front(); }
+
+    WindowStats<T> stats() const {
+        WindowStats<T> s;
+        s.count = values.size();
+        if (s.count == 0) {
+            return s;
+        }
+        s.sum      = sum;
+        s.mean     = mean;
+        s.variance = m2 / static_cast<double>(s.count);
+        s.min      = minQ.front().value;
+        s.max      = maxQ.front().value;
+        return s;
+    }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_CORE_RING_BUFFER_H
@@ -0,0 +1,60 @@
+//
+// Serializer - Value <-> bytes conversion used by persistence
+//
+
+#ifndef ZONGHENG_CORE_SERIALIZER_H
+#define ZONGHENG_CORE_SERIALIZER_H
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace ZongHeng {
+
+/**
+ * @brief Writes a value as bytes and reads it back
+ *
+ * Trivially copyable types are copied with memcpy. Other types need a
+ * specialization providing the same two functions.
+ *
+ * @example
+ * template<>
+ * struct ZongHeng::Serializer<Quote> {
+ *     static void  write(const Quote& q, std::string& out) { ... }
+ *     static Quote read(const char* data, size_t size) { ... }
+ * };
+ */
+template<class T, class = void>
+struct Serializer {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Specialize ZongHeng::Serializer<T> for types that are not trivially copyable");
+
+    static void write(const T& value, std::string& out) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static T read(const char* data, size_t size) {
+        if (size != sizeof(T)) {
+            throw std::runtime_error("Serializer: size mismatch");
+        }
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+};
+
+template<>
+struct Serializer<std::string> {
+    static void write(const std::string& value, std::string& out) {
+        out.append(value);
+    }
+
+    static std::string read(const char* data, size_t size) {
+        return std::string(data, size);
+    }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_CORE_SERIALIZER_H
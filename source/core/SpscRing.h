@@ -0,0 +1,83 @@
+//
+// SpscRing - Bounded single-producer / single-consumer queue
+//
+
+#ifndef ZONGHENG_CORE_SPSC_RING_H
+#define ZONGHENG_CORE_SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace ZongHeng {
+
+// ============================================================================
+// SpscRing - Lock-free ring between exactly two threads
+// ============================================================================
+
+/**
+ * @brief Fixed-capacity FIFO for one producer thread and one consumer thread
+ *
+ * Storage is allocated once (capacity rounded up to a power of two). The
+ * producer only writes `tail` and the consumer only writes `head`, each on
+ * its own cache line, so push() and pop() are one acquire load and one
+ * release store. push() into a full ring fails instead of waiting.
+ *
+ * @example
+ * SpscRing<uint32_t> ring(64);
+ * ring.push(7);          // producer thread
+ * uint32_t v;
+ * while (ring.pop(v)) { } // consumer thread
+ */
+template<class T>
+class SpscRing {
+    std::vector<T> data;
+    size_t         mask;
+
+    alignas(64) std::atomic<size_t> head { 0 }; // Next slot to pop (consumer)
+    alignas(64) std::atomic<size_t> tail { 0 }; // Next slot to push (producer)
+
+    static size_t roundUp(size_t n) {
+        size_t size = 1;
+        while (size < n) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+public:
+    explicit SpscRing(size_t capacity)
+        : data(roundUp(capacity ? capacity : 1))
+        , mask(data.size() - 1) { }
+
+    SpscRing(const SpscRing&)            = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer thread; false if the ring is full
+    bool push(const T& value) {
+        size_t at = tail.load(std::memory_order_relaxed);
+        if (at - head.load(std::memory_order_acquire) == data.size()) {
+            return false;
+        }
+        data[at & mask] = value;
+        tail.store(at + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread; false if the ring is empty
+    bool pop(T& value) {
+        size_t at = head.load(std::memory_order_relaxed);
+        if (at == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = data[at & mask];
+        head.store(at + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return data.size(); }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_CORE_SPSC_RING_H
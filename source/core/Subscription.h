@@ -0,0 +1,180 @@
+//
+// Batch / Subscription - Change notification delivered per propagation pass
+//
+
+#ifndef ZONGHENG_CORE_SUBSCRIPTION_H
+#define ZONGHENG_CORE_SUBSCRIPTION_H
+
+#include "ZongHengBase.h"
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace ZongHeng {
+
+/**
+ * @brief Runs a notification task, e.g. by posting it to a UI thread
+ *
+ * The task already carries the value read at the end of the pass, so it is
+ * safe to run later or on another thread.
+ */
+using Executor = std::function<void(std::function<void()>)>;
+
+template<class T, class = void>
+struct is_equality_comparable : std::false_type { };
+
+template<class T>
+struct is_equality_comparable<T, std::void_t<decltype(std::declval<const T&>() == std::declval<const T&>())>>
+    : std::true_type { };
+
+// ============================================================================
+// Batch - One propagation pass
+// ============================================================================
+
+/**
+ * @brief Groups writes into one propagation pass
+ *
+ * Every Yi::set opens a Batch; nested sets during propagation join the
+ * outermost one. When the outermost Batch closes, each node that changed
+ * during the pass notifies its subscribers exactly once with its final
+ * value, so intermediate (glitch) values are never observed.
+ *
+ * @example
+ * {
+ *     ZongHeng::Batch batch;
+ *     *bid = 100;
+ *     *ask = 101;
+ * }   // subscribers of spread are notified once here
+ */
+class Batch {
+    struct State {
+        size_t                                depth = 0;
+        std::vector<QinBase::SharedQinBase_T> pending;
+        std::vector<std::function<void()>>    deferred; // Graph edits held until the pass ends
+    };
+
+    static State& state() {
+        thread_local State s;
+        return s;
+    }
+
+    int uncaught;
+
+    static void flush() {
+        auto& s = state();
+        while (!s.pending.empty() || !s.deferred.empty()) {
+            std::vector<std::function<void()>> edits;
+            edits.swap(s.deferred);
+            for (auto& edit : edits) {
+                edit();
+            }
+
+            std::vector<QinBase::SharedQinBase_T> ready;
+            ready.swap(s.pending);
+            for (auto& node : ready) {
+                node->notifyQueued = false;
+            }
+            for (auto& node : ready) {
+                node->deliver();
+            }
+        }
+    }
+
+public:
+    Batch()
+        : uncaught(std::uncaught_exceptions()) {
+        ++state().depth;
+    }
+
+    Batch(const Batch&)            = delete;
+    Batch& operator=(const Batch&) = delete;
+
+    ~Batch() {
+        // Leave queued notifications for the next pass while unwinding
+        if (--state().depth == 0 && std::uncaught_exceptions() == uncaught) {
+            flush();
+        }
+    }
+
+    // Queue node for delivery at the end of the current pass (deduplicated)
+    static void enqueue(QinBase& node) {
+        if (node.notifyQueued) {
+            return;
+        }
+        node.notifyQueued = true;
+        state().pending.push_back(node.self);
+    }
+
+    /**
+     * @brief Run task once no propagation loop is iterating the graph
+     *
+     * Runs immediately outside a pass; otherwise when the outermost Batch
+     * closes, before subscribers are notified. Used for edge changes that
+     * would invalidate a Heng list being walked.
+     */
+    static void defer(std::function<void()> task) {
+        if (!active()) {
+            task();
+            return;
+        }
+        state().deferred.push_back(std::move(task));
+    }
+
+    static bool active() { return state().depth > 0; }
+};
+
+// ============================================================================
+// Subscription - RAII subscriber handle
+// ============================================================================
+
+/**
+ * @brief Keeps a callback registered (and its node hot) while alive
+ */
+class Subscription {
+    QinBase::SharedQinBase_T node;
+    QinBase::Observation     observation;
+    size_t                   id = 0;
+
+public:
+    Subscription() = default;
+
+    Subscription(QinBase::SharedQinBase_T node, size_t id, QinBase::Observation observation)
+        : node(std::move(node))
+        , observation(std::move(observation))
+        , id(id) { }
+
+    Subscription(const Subscription&)            = delete;
+    Subscription& operator=(const Subscription&) = delete;
+
+    Subscription(Subscription&& other) noexcept
+        : node(std::move(other.node))
+        , observation(std::move(other.observation))
+        , id(other.id) { }
+
+    Subscription& operator=(Subscription&& other) noexcept {
+        if (this != &other) {
+            reset();
+            node        = std::move(other.node);
+            observation = std::move(other.observation);
+            id          = other.id;
+        }
+        return *this;
+    }
+
+    ~Subscription() { reset(); }
+
+    void reset() {
+        if (node) {
+            node->removeSubscriber(id);
+            observation.reset();
+            node.reset();
+        }
+    }
+
+    explicit operator bool() const { return static_cast<bool>(node); }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_CORE_SUBSCRIPTION_H
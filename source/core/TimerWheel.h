@@ -0,0 +1,217 @@
+//
+// TimerWheel / Scheduler - Deadline timers for time-based operators
+//
+
+#ifndef ZONGHENG_CORE_TIMER_WHEEL_H
+#define ZONGHENG_CORE_TIMER_WHEEL_H
+
+#include "Clock.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace ZongHeng {
+
+// ============================================================================
+// TimerWheel - Hashed timing wheel
+// ============================================================================
+
+/**
+ * @brief Single-level hashed timing wheel
+ *
+ * Deadlines are rounded up to whole ticks and hashed into `slots` buckets,
+ * so schedule/cancel are O(1) and advance() only touches the buckets that
+ * the clock actually passed. Timers further than one revolution away simply
+ * stay in their bucket until their tick comes round.
+ */
+class TimerWheel {
+public:
+    using Callback   = std::function<void()>;
+    using TimerId    = std::uint64_t;
+    using duration   = Clock::duration;
+    using time_point = Clock::time_point;
+
+private:
+    struct Entry {
+        TimerId      id;
+        std::int64_t tick;
+        Callback     callback;
+    };
+
+    time_point                          origin;
+    duration                            tickSize;
+    std::vector<std::vector<Entry>>     wheel;
+    std::unordered_map<TimerId, size_t> index; // id -> bucket
+    std::int64_t                        cursor = 0;
+    TimerId                             nextId = 1;
+
+    std::int64_t tickCeil(time_point t) const {
+        auto d = (t - origin).count();
+        auto s = tickSize.count();
+        return d <= 0 ? 0 : (d + s - 1) / s;
+    }
+
+    std::int64_t tickFloor(time_point t) const {
+        auto d = (t - origin).count();
+        return d <= 0 ? 0 : d / tickSize.count();
+    }
+
+public:
+    explicit TimerWheel(time_point origin,
+                        duration   tick  = std::chrono::milliseconds(1),
+                        size_t     slots = 256)
+        : origin(origin)
+        , tickSize(tick.count() > 0 ? tick : duration(1))
+        , wheel(slots > 0 ? slots : 1) { }
+
+    /**
+     * @brief Schedule a callback to fire once the wheel reaches deadline
+     * @return Id usable with cancel()
+     */
+    TimerId schedule(time_point deadline, Callback cb) {
+        auto tick   = std::max(tickCeil(deadline), cursor + 1);
+        auto bucket = static_cast<size_t>(tick % static_cast<std::int64_t>(wheel.size()));
+        auto id     = nextId++;
+
+        wheel[bucket].push_back({ id, tick, std::move(cb) });
+        index.emplace(id, bucket);
+        return id;
+    }
+
+    /**
+     * @brief Cancel a pending timer
+     * @return false if the timer already fired or was cancelled
+     */
+    bool cancel(TimerId id) {
+        auto it = index.find(id);
+        if (it == index.end()) {
+            return false;
+        }
+
+        auto& bucket = wheel[it->second];
+        for (auto& e : bucket) {
+            if (e.id == id) {
+                std::swap(e, bucket.back());
+                bucket.pop_back();
+                break;
+            }
+        }
+        index.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief Move the wheel to `now`, firing every timer that became due
+     * @return Number of callbacks fired
+     */
+    size_t advance(time_point now) {
+        auto target = tickFloor(now);
+        if (target <= cursor) {
+            return 0;
+        }
+
+        std::vector<Entry> due;
+        auto slots = static_cast<std::int64_t>(wheel.size());
+        auto steps = std::min(target - cursor, slots);
+
+        for (std::int64_t i = 1; i <= steps; ++i) {
+            auto& bucket = wheel[static_cast<size_t>((cursor + i) % slots)];
+            for (size_t j = 0; j < bucket.size();) {
+                if (bucket[j].tick <= target) {
+                    index.erase(bucket[j].id);
+                    due.push_back(std::move(bucket[j]));
+                    bucket[j] = std::move(bucket.back());
+                    bucket.pop_back();
+                } else {
+                    ++j;
+                }
+            }
+        }
+        cursor = target;
+
+        // Fire in deadline order; callbacks may schedule follow-up timers
+        std::sort(due.begin(), due.end(), [](const Entry& l, const Entry& r) {
+            return l.tick != r.tick ? l.tick < r.tick : l.id < r.id;
+        });
+        for (auto& e : due) {
+            e.callback();
+        }
+        return due.size();
+    }
+
+    size_t size() const { return index.size(); }
+
+    duration tick() const { return tickSize; }
+};
+
+// ============================================================================
+// Scheduler - Clock + TimerWheel pair driving time-based operators
+// ============================================================================
+
+/**
+ * @brief Owns the clock and timer wheel used by throttle/debounce/windowTime
+ *
+ * Nothing fires on its own: the host loop calls poll() (e.g. once per frame
+ * or after draining an input queue) and every due timer runs on that thread.
+ *
+ * @example
+ * auto clock = std::make_shared<ManualClock>();
+ * auto sched = std::make_shared<Scheduler>(clock);
+ * auto slow  = ticks->throttle(std::chrono::milliseconds(100), sched);
+ * clock->advance(std::chrono::milliseconds(100));
+ * sched->poll();
+ */
+class Scheduler {
+public:
+    using Callback   = TimerWheel::Callback;
+    using TimerId    = TimerWheel::TimerId;
+    using duration   = Clock::duration;
+    using time_point = Clock::time_point;
+
+private:
+    std::shared_ptr<Clock> clock;
+    TimerWheel             wheel;
+
+public:
+    explicit Scheduler(std::shared_ptr<Clock> clock = std::make_shared<SteadyClock>(),
+                       duration               tick  = std::chrono::milliseconds(1),
+                       size_t                 slots = 256)
+        : clock(clock)
+        , wheel(clock->now(), tick, slots) { }
+
+    time_point now() const { return clock->now(); }
+
+    TimerId schedule(time_point deadline, Callback cb) {
+        return wheel.schedule(deadline, std::move(cb));
+    }
+
+    TimerId scheduleAfter(duration delay, Callback cb) {
+        return wheel.schedule(now() + delay, std::move(cb));
+    }
+
+    bool cancel(TimerId id) { return wheel.cancel(id); }
+
+    /**
+     * @brief Fire all timers due at the clock's current time
+     * @return Number of callbacks fired
+     */
+    size_t poll() { return wheel.advance(clock->now()); }
+
+    size_t pending() const { return wheel.size(); }
+
+    const std::shared_ptr<Clock>& getClock() const { return clock; }
+
+    // Process-wide default used when an operator is given no scheduler
+    static std::shared_ptr<Scheduler>& global() {
+        static std::shared_ptr<Scheduler> instance = std::make_shared<Scheduler>();
+        return instance;
+    }
+
+    static void setGlobal(std::shared_ptr<Scheduler> s) { global() = std::move(s); }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_CORE_TIMER_WHEEL_H
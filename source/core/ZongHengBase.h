@@ -5,24 +5,157 @@
 #ifndef ZONGHENG_CORE_BASE_H
 #define ZONGHENG_CORE_BASE_H
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <typeinfo>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // Forward declarations
 template<class INPUT_TYPE, class OUTPUT_TYPE>
 class Yi;
 
-template<class T>
+template<class T, class Fn = void>
 class Qin;
 
+class QinBase;
+
 namespace ZongHeng {
     template<class T, class Fn>
     std::shared_ptr<Qin<T>> fold(const std::vector<std::shared_ptr<Qin<T>>>&, T, Fn);
+
+    namespace detail {
+        template<class R, class Fn, class... Ts>
+        std::shared_ptr<Qin<R>> combineNodes(Fn, std::shared_ptr<Qin<Ts>>...);
+    }
+
+    template<class T>
+    class ThrottleNode;
+    template<class T>
+    class DebounceNode;
+    template<class T>
+    class SampleNode;
+    template<class T>
+    struct WindowStats;
+    template<class T>
+    class WindowNode;
+    template<class T>
+    class TimeWindowNode;
+    template<class T, class Fn>
+    class ComputedNode;
+    template<class T>
+    class MapNode;
+
+    class Batch;
+    class Snapshot;
+    class Checkpoint;
+    class Journal;
+    class FrozenGraph;
+    class ShardedGraph;
+
+    /**
+     * @brief How a node was built, recorded so a snapshot can rebuild it
+     *
+     * Built-in operators tag their result; nodes made by a builder
+     * registered with Snapshot::define are tagged Named. Everything else
+     * is a Source (or an opaque derived node that cannot be snapshotted).
+     */
+    enum class NodeKind : uint8_t {
+        Source,
+        Named,
+        // Arithmetic / bitwise (Qin<T> x Qin<T> -> Qin<T>)
+        Add, Sub, Mul, Div, Mod, BitAnd, BitOr, BitXor,
+        // Comparison (Qin<T> x Qin<T> -> Qin<bool>)
+        Eq, Ne, Lt, Gt, Le, Ge,
+        // Unary
+        Neg, BitNot, Not,
+        // map() chain (see MapNode): derived, but not rebuildable
+        Map,
+        // Immutable value (see constant()): stored like a Source
+        Constant
+    };
+
+    /**
+     * @brief Observer of every value write to a node (see Journal)
+     *
+     * Called from Yi::set after the new value is stored and before it
+     * propagates, so hooks see writes in program order.
+     */
+    class WriteHook {
+    public:
+        virtual ~WriteHook() = default;
+
+        virtual void onWrite(QinBase& node) = 0;
+    };
+
+    class NodeRegistry;
+
+    namespace detail {
+
+        inline uint32_t nextTypeTag() {
+            static std::atomic<uint32_t> counter { 0 };
+            return ++counter;
+        }
+
+        /**
+         * @brief Small integer identifying Yi<IN, OUT> (never 0)
+         *
+         * Assigned on first use, so values differ between runs; compare
+         * them, never persist them.
+         */
+        template<class IN, class OUT>
+        uint32_t typeTagOf() {
+            static const uint32_t tag = nextTypeTag();
+            return tag;
+        }
+
+        /**
+         * @brief Collects the nodes read on this thread while the scope is open
+         *
+         * computed() opens a scope around its function; Yi::get/peek record
+         * into the innermost one. Effects run under a null scope so a cold
+         * node's own upstream reads are not attributed to its reader.
+         */
+        class DependencyScope {
+            using Deps_t = std::vector<QinBase*>;
+
+            Deps_t* prev;
+
+            static Deps_t*& current() {
+                thread_local Deps_t* deps = nullptr;
+                return deps;
+            }
+
+        public:
+            explicit DependencyScope(Deps_t* deps)
+                : prev(current()) {
+                current() = deps;
+            }
+
+            DependencyScope(const DependencyScope&)            = delete;
+            DependencyScope& operator=(const DependencyScope&) = delete;
+
+            ~DependencyScope() { current() = prev; }
+
+            static void record(QinBase* node) {
+                if (auto* deps = current()) {
+                    if (std::find(deps->begin(), deps->end(), node) == deps->end()) {
+                        deps->push_back(node);
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
 }
 
 // Forward declarations for operator friends
@@ -49,25 +182,33 @@ std::shared_ptr<Qin<bool>> operator!(std::shared_ptr<Qin<T>>);
 // Type Constraint Macro
 // ============================================================================
 
+// Accept V only if TYPE_INNER can be constructed from it
 #define FORWARD_CONSTRAINT(TYPE, TYPE_INNER) <class TYPE, \
-    class = std::enable_if<                                                \
-        std::is_same<std::remove_cv<TYPE>, TYPE_INNER>::value              \
-        || std::is_constructible<TYPE, TYPE_INNER>::value                  \
-        || std::is_convertible<TYPE, TYPE_INNER>::value>>
+    class = std::enable_if_t<std::is_constructible_v<TYPE_INNER, TYPE>>>
 
 // ============================================================================
 // Type Conversion Function
 // ============================================================================
 
+// Whether convert<INPUT, OUTPUT>() compiles (otherwise a getter/setter is needed)
+template<class INPUT, class OUTPUT>
+inline constexpr bool is_convertible_value_v = std::is_convertible_v<INPUT, OUTPUT>;
+
+/**
+ * @brief Default INPUT <-> OUTPUT conversion of Yi nodes without hooks
+ *
+ * Only defined for implicitly convertible pairs: an impossible conversion
+ * is a compile error, not a runtime throw. Yi instantiations over such
+ * pairs never call it and require a getter/setter instead.
+ */
 template<class INPUT, class OUTPUT>
 OUTPUT convert(const INPUT& input) {
-    if constexpr (std::is_convertible<INPUT, OUTPUT>::value) {
-        return static_cast<OUTPUT>(input);
+    static_assert(is_convertible_value_v<INPUT, OUTPUT>,
+                  "convert(): no implicit conversion between these types (install a getter/setter)");
+    if constexpr (std::is_same_v<INPUT, OUTPUT>) {
+        return input;
     } else {
-        throw std::runtime_error(
-            std::string("Type conversion not possible: ") +
-            typeid(INPUT).name() + " -> " + typeid(OUTPUT).name()
-        );
+        return static_cast<OUTPUT>(input);
     }
 }
 
@@ -79,17 +220,33 @@ class QinBase {
 public:
     using SharedQinBase_T = std::shared_ptr<QinBase>;
 
-    virtual ~QinBase() = default;
+    explicit QinBase(uint32_t typeTag);
+
+    QinBase(const QinBase&)            = delete;
+    QinBase& operator=(const QinBase&) = delete;
+
+    virtual ~QinBase();
 
     // Friend declarations for node classes
-    template<class T>
+    template<class T, class Fn>
     friend class Qin;
     template<class IN, class OUT>
     friend class Yi;
+    friend class ZongHeng::Batch;
+    friend class ZongHeng::Snapshot;
+    friend class ZongHeng::Checkpoint;
+    friend class ZongHeng::Journal;
+    friend class ZongHeng::NodeRegistry;
+    friend class ZongHeng::FrozenGraph;
+    friend class ZongHeng::ShardedGraph;
+    template<class T>
+    friend class ZongHeng::MapNode;
 
     // Friend declarations for combinators and operators
     template<class T, class Fn>
     friend std::shared_ptr<Qin<T>> ZongHeng::fold(const std::vector<std::shared_ptr<Qin<T>>>&, T, Fn);
+    template<class R, class Fn, class... Ts>
+    friend std::shared_ptr<Qin<R>> ZongHeng::detail::combineNodes(Fn, std::shared_ptr<Qin<Ts>>...);
 
     // Comparison operators
     template<class T>
@@ -114,25 +271,160 @@ public:
     friend std::shared_ptr<Qin<bool>> operator!(std::shared_ptr<Qin<T>>);
 
 protected:
-    using Zong_t = std::vector<SharedQinBase_T>;
-    using Heng_t = std::vector<SharedQinBase_T>;
+    using Zong_t     = std::vector<SharedQinBase_T>;
+    using Heng_t     = std::vector<SharedQinBase_T>;
+    using Upstream_t = std::vector<QinBase*>;
+
+    Zong_t     Zong;     // Vertical dependencies (upstream)
+    Heng_t     Heng;     // Horizontal relationships (derived); empty entries are unlinked edges
+    Upstream_t Upstream; // Nodes this one is derived from (non-owning)
 
-    Zong_t Zong;  // Vertical dependencies (upstream)
-    Heng_t Heng;  // Horizontal relationships (derived)
+    // Where this node sits in another node's Heng or Zong. Only a hint:
+    // it is checked before use and falls back to a scan when stale.
+    struct Slot {
+        QinBase* node;
+        uint32_t index;
+    };
+
+    std::vector<Slot> HengSlots; // Per upstream edge: index in the upstream's Heng
+    std::vector<Slot> Sources;   // Nodes this one is bound to: index in their Zong
+    uint32_t          deadHeng = 0; // Empty entries in Heng awaiting compaction
 
     SharedQinBase_T self;
 
+    uint32_t id;      // Dense, stable for the node's lifetime (see NodeRegistry)
+    uint32_t typeTag; // detail::typeTagOf<IN, OUT>() of the concrete Yi
+
+    size_t   observers = 0;     // Live observers + hot derived nodes
+    bool     dirty     = false; // Upstream changed since the last recompute
+    uint64_t version   = 0;     // Bumped on every write of the value
+
+    struct Subscriber {
+        size_t                id;
+        std::function<void()> notify;
+    };
+
+    std::vector<Subscriber> Subscribers;
+    size_t                  nextSubscriberId = 1;
+    bool                    notifyQueued     = false; // Already pending in the current Batch
+
+    // Snapshot metadata (see Snapshot.h)
+    ZongHeng::NodeKind    kind   = ZongHeng::NodeKind::Source;
+    uint32_t              recipe = 0;  // Builder id for NodeKind::Named
+    std::vector<QinBase*> Operands;    // Builder arguments for NodeKind::Named
+
+    ZongHeng::WriteHook* writeHook = nullptr; // Notified on every set() (non-owning)
+    bool                 rewires   = false;   // Edges follow reads (ComputedNode): never frozen
+    bool                 disposed  = false;   // Removed from the graph (see dispose())
+    uint32_t             frozen    = 0;       // FrozenGraphs / ShardedGraphs holding this node's edges
+
 public:
+    class Observation;
+
     friend void operator<<(std::shared_ptr<QinBase> l, std::shared_ptr<QinBase> r);
 
     void bind(const std::shared_ptr<QinBase>& src);
 
-    // Public accessors for dependency graph
+    /**
+     * @brief Undo bind(src) / `this << src`
+     *
+     * The node keeps its current value (a node sharing src's storage takes
+     * a copy) and src is released. Inside a propagation pass the edge is
+     * removed when the pass ends.
+     *
+     * @param src Node this one was bound to; no-op if it is not bound
+     * @example mirror->unlink(price);
+     */
+    void unlink(const std::shared_ptr<QinBase>& src);
+
+    /**
+     * @brief Remove this node from the graph
+     *
+     * The node is brought up to date once, then loses its effect, its edges
+     * to upstream nodes and its bindings in both directions: upstream nodes
+     * stop refreshing it and it holds its last value like a source. Nodes
+     * derived from it keep their edge and see it as a source. Each edge is
+     * cut in O(1); the upstream Heng lists are compacted once enough edges
+     * are gone. Inside a propagation pass this happens when the pass ends.
+     *
+     * @throws std::runtime_error if a FrozenGraph or ShardedGraph holds the node
+     * @example widget->dispose();  // sources stop recomputing it
+     */
+    void dispose();
+
+    bool isDisposed() const { return disposed; }
+
+    // ========================================================================
+    // Hot / Cold activation
+    // ========================================================================
+
+    /**
+     * @brief Register an observer of this node
+     *
+     * A node with at least one observer is hot: it recomputes eagerly when
+     * an upstream node changes. A cold node is only marked dirty and
+     * recomputes on its next get(). The first observer makes all upstream
+     * nodes hot as well, then brings this node up to date once.
+     */
+    void retain() {
+        if (observers == 0) {
+            for (auto* up : Upstream) {
+                up->retain();
+            }
+        }
+        if (observers++ == 0) {
+            activate();
+        }
+    }
+
+    void release() {
+        if (observers == 0) {
+            return;
+        }
+        if (--observers == 0) {
+            for (auto* up : Upstream) {
+                up->release();
+            }
+        }
+    }
+
+    /**
+     * @brief Observe this node for the lifetime of the returned handle
+     * @example auto watch = total->observe();  // total is now hot
+     */
+    Observation observe();
+
+    bool     isHot() const { return observers > 0; }
+    bool     isDirty() const { return dirty; }
+    size_t   getObserverCount() const { return observers; }
+    uint64_t getVersion() const { return version; }
+
+    size_t getSubscriberCount() const { return Subscribers.size(); }
+
+    void removeSubscriber(size_t id) {
+        for (auto it = Subscribers.begin(); it != Subscribers.end(); ++it) {
+            if (it->id == id) {
+                Subscribers.erase(it);
+                return;
+            }
+        }
+    }
+
+    // Public accessors for dependency graph (Heng may hold empty entries, see dispose())
     const Zong_t& getZong() const { return Zong; }
     const Heng_t& getHeng() const { return Heng; }
 
     size_t getZongCount() const { return Zong.size(); }
-    size_t getHengCount() const { return Heng.size(); }
+    size_t getHengCount() const { return Heng.size() - deadHeng; }
+
+    ZongHeng::NodeKind getKind() const { return kind; }
+    bool               isConstant() const { return kind == ZongHeng::NodeKind::Constant; }
+
+    uint32_t getId() const { return id; }
+    uint32_t getTypeTag() const { return typeTag; }
+
+    // Concrete node type, e.g. typeid(Yi<int, int>) for Qin<int>
+    virtual const std::type_info& nodeType() const { return typeid(QinBase); }
 
     /**
      * Type-safe conversion to Yi<IN, OUT>
@@ -140,14 +432,34 @@ public:
      */
     template<class IN, class OUT>
     typename Yi<IN, OUT>::SharedYi_T into() {
-        auto result = std::dynamic_pointer_cast<Yi<IN, OUT>>(self);
-        if (!result) {
-            throw std::runtime_error(
-                std::string("Type mismatch in into(): cannot convert to Yi<") +
-                typeid(IN).name() + ", " + typeid(OUT).name() + ">"
-            );
+        if (!isA<IN, OUT>() || !self) {
+            typeMismatch<IN, OUT>("into");
+        }
+        return std::static_pointer_cast<Yi<IN, OUT>>(self);
+    }
+
+    /**
+     * @brief Non-owning conversion to Yi<IN, OUT>
+     *
+     * One integer compare of type tags, no RTTI and no shared_ptr copy;
+     * meant for hot paths such as operator effects. The reference is
+     * valid as long as the node is.
+     *
+     * @throws std::runtime_error if type mismatch
+     * @example int v = q->into_ref<int, int>().get();
+     */
+    template<class IN, class OUT>
+    Yi<IN, OUT>& into_ref() {
+        if (!isA<IN, OUT>()) {
+            typeMismatch<IN, OUT>("into_ref");
         }
-        return result;
+        return static_cast<Yi<IN, OUT>&>(*this);
+    }
+
+    // Whether this node is a Yi<IN, OUT> (or derived from one)
+    template<class IN, class OUT>
+    bool isA() const {
+        return typeTag == ZongHeng::detail::typeTagOf<IN, OUT>();
     }
 
 protected:
@@ -156,18 +468,349 @@ protected:
      *
      * Registers this node as derived from q1 and q2 by adding this node
      * to their Heng (downstream) lists. This is a core building block for
-     * reactive dependencies.
+     * reactive dependencies. Unary nodes pass the same node twice; it is
+     * registered once so each upstream write refreshes this node once.
      *
      * Protected to prevent misuse - only accessible to framework internals
      * (Yi/Qin classes and friend operators/combinators).
      */
     void lian(const SharedQinBase_T& q1, const SharedQinBase_T& q2) {
-        q1->Heng.push_back(self);
-        q2->Heng.push_back(self);
+        connect(q1, self);
+        if (q2 != q1) {
+            connect(q2, self);
+        }
+    }
+
+    template<class IN, class OUT>
+    [[noreturn]] static void typeMismatch(const char* where) {
+        throw std::runtime_error(
+            std::string("Type mismatch in ") + where + "(): cannot convert to Yi<" +
+            typeid(IN).name() + ", " + typeid(OUT).name() + ">"
+        );
     }
 
     // Internal: Add a derived node (for combinators that need direct access)
-    void addDerivedNode(const SharedQinBase_T& node) { Heng.push_back(node); }
+    void addDerivedNode(const SharedQinBase_T& node) { connect(self, node); }
+
+    // Internal: Register `node` as derived from `upstream` (for node subclasses)
+    static void connect(const SharedQinBase_T& upstream, const SharedQinBase_T& node) {
+        upstream->attach();
+        upstream->Heng.push_back(node);
+        node->HengSlots.push_back({ upstream.get(), static_cast<uint32_t>(upstream->Heng.size() - 1) });
+        node->Upstream.push_back(upstream.get());
+        if (node->isHot()) {
+            upstream->retain();
+        }
+    }
+
+    // Internal: Undo connect(upstream, this)
+    void disconnect(QinBase* upstream) {
+        auto keep = self; // the cleared Heng entry may hold the last external reference
+        if (!dropHeng(upstream)) {
+            return;
+        }
+        Upstream.erase(std::find(Upstream.begin(), Upstream.end(), upstream));
+        if (isHot()) {
+            upstream->release();
+        }
+    }
+
+    // Index of `node` in list, trying the hint first; list.size() if absent
+    template<class List>
+    static size_t locate(const List& list, const std::vector<Slot>& slots, const QinBase* owner, const QinBase* node) {
+        for (auto& slot : slots) {
+            if (slot.node == owner && slot.index < list.size() && list[slot.index].get() == node) {
+                return slot.index;
+            }
+        }
+        return std::find_if(list.begin(), list.end(), [node](const SharedQinBase_T& entry) {
+            return entry.get() == node;
+        }) - list.begin();
+    }
+
+    // Empty this node's entry in upstream->Heng (positions of the others are kept)
+    bool dropHeng(QinBase* upstream);
+
+    // Remove the Heng entries emptied by dropHeng(), once no pass is walking them
+    void compactHeng();
+
+    // Refresh the HengSlots hints of derived nodes after Heng was reordered
+    void reslotHeng();
+
+    // Remove the binding of this node to src (see unlink())
+    void unbind(QinBase* src);
+
+    // Internal: Make Upstream equal to `wanted` (nodes with dynamic dependencies)
+    void rewire(const Upstream_t& wanted) {
+        if (disposed) {
+            return; // a rewire deferred before dispose()
+        }
+        for (size_t i = Upstream.size(); i-- > 0;) {
+            if (std::find(wanted.begin(), wanted.end(), Upstream[i]) == wanted.end()) {
+                disconnect(Upstream[i]);
+            }
+        }
+        for (auto* up : wanted) {
+            if (std::find(Upstream.begin(), Upstream.end(), up) == Upstream.end()) {
+                connect(up->self, self);
+            }
+        }
+    }
+
+    // Flag this node and its cold subgraph as stale; stops at stale nodes
+    void markDirty() {
+        if (dirty) {
+            return;
+        }
+        dirty = true;
+        invalidate();
+    }
+
+    // Mark everything derived from this node stale without recomputing it
+    void invalidate() {
+        for (auto& heng : Heng) {
+            if (heng) {
+                heng->markDirty();
+            }
+        }
+    }
+
+    // Called once when the node turns hot; effect nodes catch up here
+    virtual void activate() { }
+
+    // Called before a node gains a derived node; fused map nodes reconnect here
+    virtual void attach() { }
+
+    // Called by dispose(): settle the value and drop the effect
+    virtual void retire() { }
+
+    // Called when the binding to src is removed; a node sharing src's storage copies it
+    virtual void unbound(QinBase& src) { (void)src; }
+
+    size_t addSubscriber(std::function<void()> notify) {
+        auto id = nextSubscriberId++;
+        Subscribers.push_back({ id, std::move(notify) });
+        return id;
+    }
+
+    // Run every subscriber once (end of a Batch); tolerates unsubscribes
+    void deliver() {
+        auto current = Subscribers;
+        for (auto& sub : current) {
+            sub.notify();
+        }
+    }
+
+    /**
+     * @brief Recompute this node after one of its upstream nodes changed
+     *
+     * Called by the propagation loop in Yi::set for every Heng entry,
+     * regardless of the entry's value type. Effect nodes recompute and
+     * forward; stateful nodes (throttle, debounce, ...) override this to
+     * decide when to forward.
+     */
+    virtual void refresh() { }
+
+    /**
+     * @brief refresh() knowing which upstream node changed
+     *
+     * What the propagation loops call. Nodes that fold many inputs
+     * incrementally (see CountNode) override this to update only the
+     * changed input's contribution.
+     */
+    virtual void refreshFrom(QinBase& upstream) {
+        (void)upstream;
+        refresh();
+    }
 };
 
+// ============================================================================
+// QinBase::Observation - RAII observer handle
+// ============================================================================
+
+/**
+ * @brief Keeps a node hot while alive (see QinBase::retain)
+ */
+class QinBase::Observation {
+    SharedQinBase_T node;
+
+public:
+    Observation() = default;
+
+    explicit Observation(SharedQinBase_T n)
+        : node(std::move(n)) {
+        if (node) {
+            node->retain();
+        }
+    }
+
+    Observation(const Observation&)            = delete;
+    Observation& operator=(const Observation&) = delete;
+
+    Observation(Observation&& other) noexcept
+        : node(std::move(other.node)) { }
+
+    Observation& operator=(Observation&& other) noexcept {
+        if (this != &other) {
+            reset();
+            node = std::move(other.node);
+        }
+        return *this;
+    }
+
+    ~Observation() { reset(); }
+
+    void reset() {
+        if (node) {
+            node->release();
+            node.reset();
+        }
+    }
+
+    explicit operator bool() const { return static_cast<bool>(node); }
+};
+
+inline QinBase::Observation QinBase::observe() {
+    return Observation(self);
+}
+
+// ============================================================================
+// NodeRegistry - Dense node ids and interned names
+// ============================================================================
+
+/**
+ * @brief Maps node ids and names to nodes
+ *
+ * Every node gets the next dense id when constructed, so per-node metadata
+ * can live in flat arrays indexed by getId() and sized by size(). Nodes can
+ * also be given a unique name for lookup from configuration. Typed lookups
+ * compare type tags instead of using dynamic_pointer_cast.
+ *
+ * Like the rest of the graph, the registry is not synchronized.
+ *
+ * @example
+ * auto& nodes = ZongHeng::NodeRegistry::global();
+ * nodes.name(price, "price");
+ * auto p = nodes.find<int>("price");       // std::shared_ptr<Qin<int>>
+ * std::vector<float> weight(nodes.size()); // indexed by node->getId()
+ */
+class ZongHeng::NodeRegistry {
+    std::vector<QinBase*>                          nodes;  // By id; nullptr once destroyed
+    std::vector<const std::string*>                names;  // By id; nullptr if unnamed
+    std::unordered_set<std::string>                pool;   // Interned names (stable addresses)
+    std::unordered_map<std::string_view, uint32_t> byName;
+
+    friend class ::QinBase;
+
+    uint32_t enroll(QinBase* node) {
+        nodes.push_back(node);
+        names.push_back(nullptr);
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+
+    void withdraw(uint32_t id) {
+        if (names[id]) {
+            byName.erase(*names[id]);
+            names[id] = nullptr;
+        }
+        nodes[id] = nullptr;
+    }
+
+    const std::string* intern(std::string_view name) {
+        return &*pool.emplace(name).first;
+    }
+
+    template<class T>
+    static std::shared_ptr<Qin<T>> typed(QinBase* node) {
+        if (!node) {
+            return nullptr;
+        }
+        if (!node->template isA<T, T>()) {
+            throw std::runtime_error(std::string("NodeRegistry: node is not a Qin<") + typeid(T).name() + ">");
+        }
+        return std::static_pointer_cast<Qin<T>>(node->self);
+    }
+
+public:
+    static NodeRegistry& global() {
+        static auto* registry = new NodeRegistry; // Outlives nodes destroyed at exit
+        return *registry;
+    }
+
+    // Number of ids handed out so far (ids are < size())
+    size_t size() const { return nodes.size(); }
+
+    /**
+     * @brief Give a node a unique name (replacing its previous one)
+     * @throws std::runtime_error if another live node has this name
+     */
+    void name(const std::shared_ptr<QinBase>& node, std::string_view name) {
+        auto found = byName.find(name);
+        if (found != byName.end()) {
+            if (found->second == node->id) {
+                return;
+            }
+            throw std::runtime_error("NodeRegistry: name already in use: " + std::string(name));
+        }
+
+        if (names[node->id]) {
+            byName.erase(*names[node->id]);
+        }
+        names[node->id] = intern(name);
+        byName.emplace(*names[node->id], node->id);
+    }
+
+    // Name of a node, empty if it has none
+    std::string_view nameOf(uint32_t id) const {
+        return id < names.size() && names[id] ? std::string_view(*names[id]) : std::string_view();
+    }
+
+    // Node by id, nullptr if out of range or destroyed
+    QinBase::SharedQinBase_T get(uint32_t id) const {
+        return id < nodes.size() && nodes[id] ? nodes[id]->self : nullptr;
+    }
+
+    /**
+     * @brief Node by id as Qin<T>
+     * @return nullptr if there is no such node
+     * @throws std::runtime_error if the node holds another type
+     */
+    template<class T>
+    std::shared_ptr<Qin<T>> get(uint32_t id) const {
+        return typed<T>(id < nodes.size() ? nodes[id] : nullptr);
+    }
+
+    // Node by name, nullptr if unknown
+    QinBase::SharedQinBase_T find(std::string_view name) const {
+        auto found = byName.find(name);
+        return found != byName.end() ? nodes[found->second]->self : nullptr;
+    }
+
+    /**
+     * @brief Node by name as Qin<T>
+     * @return nullptr if the name is unknown
+     * @throws std::runtime_error if the node holds another type
+     */
+    template<class T>
+    std::shared_ptr<Qin<T>> find(std::string_view name) const {
+        auto found = byName.find(name);
+        return typed<T>(found != byName.end() ? nodes[found->second] : nullptr);
+    }
+};
+
+inline QinBase::QinBase(uint32_t typeTag)
+    : id(ZongHeng::NodeRegistry::global().enroll(this))
+    , typeTag(typeTag) { }
+
+inline QinBase::~QinBase() {
+    // Nodes bound to this one can outlive it: forget their binding
+    for (auto& bound : Zong) {
+        auto& sources = bound->Sources;
+        sources.erase(std::remove_if(sources.begin(), sources.end(), [this](const Slot& slot) {
+            return slot.node == this;
+        }), sources.end());
+    }
+    ZongHeng::NodeRegistry::global().withdraw(id);
+}
+
 #endif // ZONGHENG_CORE_BASE_H
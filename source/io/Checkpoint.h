@@ -0,0 +1,480 @@
+//
+// Checkpoint - Incremental persistence of source node values
+//
+
+#ifndef ZONGHENG_IO_CHECKPOINT_H
+#define ZONGHENG_IO_CHECKPOINT_H
+
+#include "MappedFile.h"
+#include "../core/Serializer.h"
+#include "../nodes/Qin.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ZongHeng {
+
+// ============================================================================
+// Checkpoint - Append-only value log for crash recovery
+// ============================================================================
+
+/**
+ * @brief Persists the values of tracked source nodes to an append-only log
+ *
+ * Every write bumps a node's version; checkpoint() appends only the nodes
+ * whose version moved since they were last written, followed by a commit
+ * record. A crash mid-checkpoint leaves a torn tail that is ignored on
+ * restore and cut off when the log is reopened. Once the log grows past
+ * `compactionRatio` times its size after the last compaction, it is
+ * rewritten with one record per key.
+ *
+ * Values go through ZongHeng::Serializer<T>: memcpy for trivially copyable
+ * types, a user specialization otherwise.
+ *
+ * @example
+ * Checkpoint cp("state.log");
+ * cp.track("price", price);
+ * cp.track("qty", qty);
+ * cp.restore();      // after a restart: reload and propagate once
+ * ...
+ * cp.checkpoint();   // periodically: append what changed
+ */
+class Checkpoint {
+    static constexpr char     Magic[4]       = { 'Z', 'H', 'C', 'K' };
+    static constexpr uint32_t Version        = 1;
+    static constexpr size_t   HeaderSize     = sizeof(Magic) + sizeof(Version);
+    static constexpr uint64_t MinCompactSize = 4096; // Never compact logs smaller than this
+
+    enum RecordType : uint8_t {
+        NameRecord   = 1, // payload: key id, key name
+        ValueRecord  = 2, // payload: key id, node version, value bytes
+        CommitRecord = 3  // payload: sequence number
+    };
+
+    struct RecordHeader {
+        uint8_t  type;
+        uint8_t  reserved[3];
+        uint32_t size;
+    };
+
+    struct Stored {
+        uint64_t    version = 0;
+        std::string bytes;
+    };
+
+    // Committed contents of a log file
+    struct LogState {
+        std::unordered_map<std::string, uint32_t> ids;
+        std::unordered_map<std::string, Stored>   values;
+        uint64_t                                  sequence     = 0;
+        uint64_t                                  committedEnd = 0;
+        bool                                      exists       = false;
+    };
+
+    struct Entry {
+        std::string              key;
+        uint32_t                 id;
+        QinBase::SharedQinBase_T node;
+        bool                     named     = false; // Name record already in the log
+        bool                     persisted = false;
+        uint64_t                 written   = 0;     // Version last persisted
+        void (*save)(QinBase&, std::string&);
+        void (*load)(QinBase&, const char*, size_t);
+        void (*propagate)(QinBase&);
+    };
+
+    std::string        path;
+    double             compactionRatio;
+    std::ofstream      log;
+    std::vector<Entry> entries;
+
+    std::unordered_map<std::string, uint32_t> keyIds;
+    uint32_t                                  nextId   = 0;
+    uint64_t                                  sequence = 0;
+    uint64_t                                  fileSize = 0;
+    uint64_t                                  liveSize = 0; // Size after the last compaction
+
+    // ========================================================================
+    // Per-type operations
+    // ========================================================================
+
+    template<class T>
+    static Yi<T, T>& yi(QinBase& node) {
+        return static_cast<Yi<T, T>&>(node);
+    }
+
+    template<class T>
+    static void saveValue(QinBase& node, std::string& out) {
+        Serializer<T>::write(yi<T>(node).storage(), out);
+    }
+
+    template<class T>
+    static void loadValue(QinBase& node, const char* data, size_t size) {
+        yi<T>(node).set_raw(Serializer<T>::read(data, size));
+    }
+
+    // Forward a value loaded with set_raw (bindings, hot nodes, subscribers)
+    template<class T>
+    static void propagateValue(QinBase& base) {
+        auto& node = yi<T>(base);
+
+        if (!node.Subscribers.empty()) {
+            Batch::enqueue(node);
+        }
+
+        for (auto& target : node.Zong) {
+            if (!target->template isA<T, T>()) {
+                continue; // Skip incompatible type nodes
+            }
+            try {
+                target->template into_ref<T, T>().set(node.rawValue);
+            } catch (const std::runtime_error&) {
+                // Skip nodes whose setter rejects the value
+            }
+        }
+
+        // Cold nodes were marked dirty by set_raw; hot nodes that an earlier
+        // restored source already refreshed are clean and skipped here
+        for (auto& heng : node.Heng) {
+            if (heng && heng->isHot() && heng->isDirty()) {
+                try {
+                    heng->refreshFrom(node);
+                } catch (const std::runtime_error&) {
+                    // Skip nodes that cannot accept the recomputed value
+                }
+            }
+        }
+    }
+
+    // ========================================================================
+    // Log format
+    // ========================================================================
+
+    static void appendRecord(std::string& out, RecordType type, const std::string& payload) {
+        RecordHeader header {};
+        header.type = type;
+        header.size = static_cast<uint32_t>(payload.size());
+        out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.append(payload);
+    }
+
+    template<class V>
+    static void put(std::string& out, const V& v) {
+        out.append(reinterpret_cast<const char*>(&v), sizeof(V));
+    }
+
+    template<class V>
+    static V take(const char*& at) {
+        V v;
+        std::memcpy(&v, at, sizeof(V));
+        at += sizeof(V);
+        return v;
+    }
+
+    static std::string fileHeader() {
+        std::string out(Magic, sizeof(Magic));
+        put(out, Version);
+        return out;
+    }
+
+    // Read everything up to the last complete commit record
+    static LogState scan(const std::string& path) {
+        LogState state;
+        if (!std::filesystem::exists(path)) {
+            return state;
+        }
+        state.exists = true;
+
+        MappedFile  file(path);
+        const char* base = file.data();
+        size_t      size = file.size();
+
+        if (size < HeaderSize || std::memcmp(base, Magic, sizeof(Magic)) != 0) {
+            throw std::runtime_error("Checkpoint: not a checkpoint log: " + path);
+        }
+        state.committedEnd = HeaderSize;
+
+        std::unordered_map<uint32_t, std::string> names;
+        std::unordered_map<uint32_t, std::string> pendingNames;
+        std::unordered_map<uint32_t, Stored>      pendingValues;
+
+        size_t offset = HeaderSize;
+        while (size - offset >= sizeof(RecordHeader)) {
+            RecordHeader header;
+            std::memcpy(&header, base + offset, sizeof(header));
+            if (header.size > size - offset - sizeof(header)) {
+                break; // torn tail
+            }
+
+            const char* at  = base + offset + sizeof(header);
+            const char* end = at + header.size;
+            offset += sizeof(header) + header.size;
+
+            if (header.type == NameRecord && header.size >= sizeof(uint32_t)) {
+                auto id = take<uint32_t>(at);
+                pendingNames[id].assign(at, end);
+            } else if (header.type == ValueRecord && header.size >= sizeof(uint32_t) + sizeof(uint64_t)) {
+                auto  id      = take<uint32_t>(at);
+                auto& pending = pendingValues[id];
+                pending.version = take<uint64_t>(at);
+                pending.bytes.assign(at, end);
+            } else if (header.type == CommitRecord && header.size == sizeof(uint64_t)) {
+                state.sequence = take<uint64_t>(at);
+                for (auto& [id, name] : pendingNames) {
+                    names[id]       = name;
+                    state.ids[name] = id;
+                }
+                for (auto& [id, stored] : pendingValues) {
+                    auto name = names.find(id);
+                    if (name != names.end()) {
+                        state.values[name->second] = std::move(stored);
+                    }
+                }
+                pendingNames.clear();
+                pendingValues.clear();
+                state.committedEnd = offset;
+            } else {
+                break; // unknown record: treat the rest as torn
+            }
+        }
+
+        return state;
+    }
+
+    void openForAppend() {
+        log.open(path, std::ios::binary | std::ios::app);
+        if (!log) {
+            throw std::runtime_error("Checkpoint: cannot open " + path);
+        }
+    }
+
+public:
+    /**
+     * @brief Open (or create) a checkpoint log
+     * @param path Log file; an uncommitted tail from a crash is truncated
+     * @param compactionRatio Compact once the log exceeds this multiple of
+     *        its size after the last compaction
+     * @throws std::runtime_error if the file exists but is not a log
+     */
+    explicit Checkpoint(std::string path, double compactionRatio = 4.0)
+        : path(std::move(path))
+        , compactionRatio(compactionRatio) {
+        auto state = scan(this->path);
+
+        if (state.exists) {
+            for (auto& [name, id] : state.ids) {
+                keyIds[name] = id;
+                nextId       = std::max(nextId, id + 1);
+            }
+            sequence = state.sequence;
+            std::filesystem::resize_file(this->path, state.committedEnd);
+            fileSize = state.committedEnd;
+        } else {
+            std::ofstream out(this->path, std::ios::binary | std::ios::trunc);
+            auto          header = fileHeader();
+            out.write(header.data(), static_cast<std::streamsize>(header.size()));
+            fileSize = header.size();
+        }
+
+        liveSize = fileSize;
+        openForAppend();
+    }
+
+    Checkpoint(const Checkpoint&)            = delete;
+    Checkpoint& operator=(const Checkpoint&) = delete;
+
+    /**
+     * @brief Persist a source node under a stable key
+     * @throws std::runtime_error if the node is derived or the key is taken
+     */
+    template<class T>
+    void track(const std::string& key, const std::shared_ptr<Qin<T>>& node) {
+        if (!node->Upstream.empty() || node->effect) {
+            throw std::runtime_error("Checkpoint: only source nodes can be tracked: " + key);
+        }
+        for (auto& entry : entries) {
+            if (entry.key == key) {
+                throw std::runtime_error("Checkpoint: key already tracked: " + key);
+            }
+        }
+
+        Entry entry { key, 0, node };
+        auto  known = keyIds.find(key);
+        if (known != keyIds.end()) {
+            entry.id    = known->second;
+            entry.named = true;
+        } else {
+            entry.id    = nextId++;
+            keyIds[key] = entry.id;
+        }
+        entry.save      = &saveValue<T>;
+        entry.load      = &loadValue<T>;
+        entry.propagate = &propagateValue<T>;
+        entries.push_back(std::move(entry));
+    }
+
+    /**
+     * @brief Append the values that changed since the last checkpoint
+     * @return Number of values written (0 writes nothing, not even a commit)
+     */
+    size_t checkpoint() {
+        std::string out;
+        std::string payload;
+        size_t      count = 0;
+
+        for (auto& entry : entries) {
+            auto version = entry.node->version;
+            if (entry.persisted && entry.written == version) {
+                continue;
+            }
+
+            if (!entry.named) {
+                payload.clear();
+                put(payload, entry.id);
+                payload.append(entry.key);
+                appendRecord(out, NameRecord, payload);
+                entry.named = true;
+            }
+
+            payload.clear();
+            put(payload, entry.id);
+            put(payload, version);
+            entry.save(*entry.node, payload);
+            appendRecord(out, ValueRecord, payload);
+
+            entry.persisted = true;
+            entry.written   = version;
+            ++count;
+        }
+
+        if (count == 0) {
+            return 0;
+        }
+
+        payload.clear();
+        put(payload, ++sequence);
+        appendRecord(out, CommitRecord, payload);
+
+        log.write(out.data(), static_cast<std::streamsize>(out.size()));
+        log.flush();
+        if (!log) {
+            throw std::runtime_error("Checkpoint: write failed: " + path);
+        }
+        fileSize += out.size();
+
+        if (fileSize > compactionRatio * static_cast<double>(std::max(liveSize, MinCompactSize))) {
+            compact();
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Rewrite the log with one record per key
+     *
+     * Keeps committed values of keys not tracked by this process; tracked
+     * nodes are written with their current value. The new log replaces the
+     * old one atomically (write to a temporary file, then rename).
+     */
+    void compact() {
+        log.close();
+
+        auto state = scan(path);
+        for (auto& entry : entries) {
+            auto& stored   = state.values[entry.key];
+            stored.version = entry.node->version;
+            stored.bytes.clear();
+            entry.save(*entry.node, stored.bytes);
+        }
+
+        std::unordered_map<std::string, uint32_t> ids;
+        std::string                               out = fileHeader();
+        std::string                               payload;
+
+        for (auto& [key, stored] : state.values) {
+            auto id = static_cast<uint32_t>(ids.size());
+            ids[key] = id;
+
+            payload.clear();
+            put(payload, id);
+            payload.append(key);
+            appendRecord(out, NameRecord, payload);
+
+            payload.clear();
+            put(payload, id);
+            put(payload, stored.version);
+            payload.append(stored.bytes);
+            appendRecord(out, ValueRecord, payload);
+        }
+
+        payload.clear();
+        put(payload, ++sequence);
+        appendRecord(out, CommitRecord, payload);
+
+        auto tmp = path + ".compact";
+        {
+            std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+            if (!file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+                throw std::runtime_error("Checkpoint: cannot write " + tmp);
+            }
+        }
+        std::filesystem::rename(tmp, path);
+
+        keyIds = std::move(ids);
+        nextId = static_cast<uint32_t>(keyIds.size());
+        for (auto& entry : entries) {
+            entry.id        = keyIds[entry.key];
+            entry.named     = true;
+            entry.persisted = true;
+            entry.written   = entry.node->version;
+        }
+
+        fileSize = liveSize = out.size();
+        openForAppend();
+    }
+
+    /**
+     * @brief Load the last committed value of every tracked node
+     *
+     * All values are loaded first, then forwarded in a single Batch, so
+     * derived nodes see the complete restored state and subscribers are
+     * notified once.
+     *
+     * @return Number of nodes restored
+     */
+    size_t restore() {
+        auto                state = scan(path);
+        std::vector<Entry*> restored;
+
+        Batch batch;
+
+        for (auto& entry : entries) {
+            auto found = state.values.find(entry.key);
+            if (found == state.values.end()) {
+                continue;
+            }
+            entry.load(*entry.node, found->second.bytes.data(), found->second.bytes.size());
+            restored.push_back(&entry);
+        }
+
+        for (auto* entry : restored) {
+            entry->propagate(*entry->node);
+            entry->persisted = true;
+            entry->written   = entry->node->version;
+        }
+
+        return restored.size();
+    }
+
+    size_t   getTrackedCount() const { return entries.size(); }
+    uint64_t getLogSize() const { return fileSize; }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_IO_CHECKPOINT_H
@@ -0,0 +1,466 @@
+//
+// Journal - Write-ahead log of source writes, and deterministic replay
+//
+
+#ifndef ZONGHENG_IO_JOURNAL_H
+#define ZONGHENG_IO_JOURNAL_H
+
+#include "MappedFile.h"
+#include "../core/Serializer.h"
+#include "../nodes/Qin.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ZongHeng {
+
+// ============================================================================
+// Journal file format (shared by Journal and Replayer)
+// ============================================================================
+
+namespace detail {
+
+    struct JournalFormat {
+        static constexpr char     Magic[4] = { 'Z', 'H', 'W', 'J' };
+        static constexpr uint32_t Version  = 1;
+
+        enum RecordType : uint8_t {
+            NameRecord  = 1, // payload: key id, key name
+            BlockRecord = 2  // payload: sequence of (EntryHeader, value bytes)
+        };
+
+        struct RecordHeader {
+            uint8_t  type;
+            uint8_t  reserved[3];
+            uint32_t size;
+        };
+
+        struct EntryHeader {
+            uint32_t id;        // Key id (see NameRecord)
+            uint32_t size;      // Value bytes following the header
+            uint64_t sequence;  // Global write order
+            int64_t  timestamp; // steady_clock nanoseconds
+        };
+    };
+
+} // namespace detail
+
+// ============================================================================
+// Journal - Records every write to tracked source nodes
+// ============================================================================
+
+/**
+ * @brief Write-ahead journal of Yi::set on source nodes
+ *
+ * Each write to a tracked node appends (key id, sequence, timestamp, value
+ * bytes) to a buffer owned by the writing thread, so the recording path
+ * takes no lock. Full buffers are published on a lock-free stack and
+ * written to the file in batches by whichever thread gets the file first;
+ * the others just keep recording.
+ *
+ * flush() publishes the calling thread's partial buffer and writes all
+ * published ones. flushAll() (and the destructor) also drains the buffers
+ * of other threads, so it must only run while no other thread is writing.
+ *
+ * Values go through ZongHeng::Serializer<T>.
+ *
+ * @example
+ * Journal journal("graph.wal");
+ * journal.track("bid", bid);
+ * journal.track("ask", ask);
+ * *bid = 100;   // recorded
+ */
+class Journal {
+    using Format = detail::JournalFormat;
+
+    struct Block {
+        std::string data;
+        Block*      next = nullptr; // Published stack
+    };
+
+    // One per (journal, thread): the thread's partial block
+    struct Slot {
+        Block* current = nullptr;
+        Slot*  next    = nullptr;
+    };
+
+    class Tap : public WriteHook {
+    public:
+        Journal* journal;
+        uint32_t id;
+        void (*save)(QinBase&, std::string&);
+
+        Tap(Journal* journal, uint32_t id, void (*save)(QinBase&, std::string&))
+            : journal(journal)
+            , id(id)
+            , save(save) { }
+
+        void onWrite(QinBase& node) override {
+            journal->record(id, node, save);
+        }
+    };
+
+    const uint64_t uid; // Distinguishes journals in the thread-local slot cache
+    size_t         blockSize;
+
+    std::atomic<uint64_t> sequence { 0 };
+    std::atomic<Block*>   published { nullptr };
+    std::atomic<Slot*>    slots { nullptr };
+
+    std::mutex    fileLock;
+    std::ofstream file;
+
+    std::vector<std::unique_ptr<Tap>>     taps;
+    std::vector<QinBase::SharedQinBase_T> tracked;
+
+    static uint64_t nextUid() {
+        static std::atomic<uint64_t> counter { 1 };
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template<class T>
+    static void saveValue(QinBase& node, std::string& out) {
+        Serializer<T>::write(static_cast<Yi<T, T>&>(node).storage(), out);
+    }
+
+    Slot& localSlot() {
+        thread_local std::vector<std::pair<uint64_t, Slot*>> cache;
+        for (auto& [owner, slot] : cache) {
+            if (owner == uid) {
+                return *slot;
+            }
+        }
+
+        auto* slot = new Slot;
+        slot->next = slots.load(std::memory_order_relaxed);
+        while (!slots.compare_exchange_weak(slot->next, slot, std::memory_order_release,
+                                            std::memory_order_relaxed)) { }
+        cache.emplace_back(uid, slot);
+        return *slot;
+    }
+
+    void publish(Block* block) {
+        block->next = published.load(std::memory_order_relaxed);
+        while (!published.compare_exchange_weak(block->next, block, std::memory_order_release,
+                                                std::memory_order_relaxed)) { }
+    }
+
+    // Write every published block; returns false if another thread is writing
+    bool drain(bool wait) {
+        std::unique_lock<std::mutex> lock(fileLock, std::defer_lock);
+        if (wait) {
+            lock.lock();
+        } else if (!lock.try_lock()) {
+            return false;
+        }
+
+        Block* list = published.exchange(nullptr, std::memory_order_acquire);
+
+        // The stack is LIFO; write in publication order
+        Block* ordered = nullptr;
+        while (list) {
+            auto* next = list->next;
+            list->next = ordered;
+            ordered    = list;
+            list       = next;
+        }
+
+        while (ordered) {
+            auto* next = ordered->next;
+            writeRecord(Format::BlockRecord, ordered->data);
+            delete ordered;
+            ordered = next;
+        }
+        file.flush();
+        return true;
+    }
+
+    void writeRecord(uint8_t type, const std::string& payload) {
+        Format::RecordHeader header {};
+        header.type = type;
+        header.size = static_cast<uint32_t>(payload.size());
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    }
+
+    void record(uint32_t id, QinBase& node, void (*save)(QinBase&, std::string&)) {
+        auto& slot = localSlot();
+        if (!slot.current) {
+            slot.current = new Block;
+            slot.current->data.reserve(blockSize + 256);
+        }
+
+        auto&  data = slot.current->data;
+        size_t at   = data.size();
+        data.resize(at + sizeof(Format::EntryHeader));
+        save(node, data);
+
+        Format::EntryHeader entry {};
+        entry.id        = id;
+        entry.size      = static_cast<uint32_t>(data.size() - at - sizeof(entry));
+        entry.sequence  = sequence.fetch_add(1, std::memory_order_relaxed);
+        entry.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch())
+                              .count();
+        std::memcpy(&data[at], &entry, sizeof(entry));
+
+        if (data.size() >= blockSize) {
+            publish(slot.current);
+            slot.current = nullptr;
+            drain(false);
+        }
+    }
+
+public:
+    /**
+     * @brief Create (truncate) a journal file
+     * @param blockSize Bytes buffered per thread before a batch is written
+     * @throws std::runtime_error if the file cannot be created
+     */
+    explicit Journal(const std::string& path, size_t blockSize = 64 * 1024)
+        : uid(nextUid())
+        , blockSize(blockSize) {
+        file.open(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Journal: cannot create " + path);
+        }
+        file.write(Format::Magic, sizeof(Format::Magic));
+        file.write(reinterpret_cast<const char*>(&Format::Version), sizeof(Format::Version));
+    }
+
+    Journal(const Journal&)            = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    ~Journal() {
+        for (auto& node : tracked) {
+            node->writeHook = nullptr;
+        }
+        flushAll();
+
+        auto* slot = slots.load(std::memory_order_acquire);
+        while (slot) {
+            auto* next = slot->next;
+            delete slot;
+            slot = next;
+        }
+    }
+
+    /**
+     * @brief Record every write to a source node under a stable key
+     * @throws std::runtime_error if the node is derived or already hooked
+     */
+    template<class T>
+    void track(const std::string& key, const std::shared_ptr<Qin<T>>& node) {
+        if (!node->Upstream.empty() || node->effect) {
+            throw std::runtime_error("Journal: only source nodes can be tracked: " + key);
+        }
+        if (node->writeHook) {
+            throw std::runtime_error("Journal: node already has a write hook: " + key);
+        }
+
+        auto id = static_cast<uint32_t>(taps.size());
+
+        std::string payload(reinterpret_cast<const char*>(&id), sizeof(id));
+        payload.append(key);
+        {
+            std::lock_guard<std::mutex> lock(fileLock);
+            writeRecord(Format::NameRecord, payload);
+        }
+
+        taps.push_back(std::make_unique<Tap>(this, id, &saveValue<T>));
+        node->writeHook = taps.back().get();
+        tracked.push_back(node);
+    }
+
+    /**
+     * @brief Write the calling thread's buffer and every published batch
+     */
+    void flush() {
+        auto& slot = localSlot();
+        if (slot.current && !slot.current->data.empty()) {
+            publish(slot.current);
+            slot.current = nullptr;
+        }
+        drain(true);
+    }
+
+    /**
+     * @brief Write all buffered entries of every thread
+     *
+     * Only call while no other thread records into this journal.
+     */
+    void flushAll() {
+        for (auto* slot = slots.load(std::memory_order_acquire); slot; slot = slot->next) {
+            if (slot->current) {
+                if (slot->current->data.empty()) {
+                    delete slot->current;
+                } else {
+                    publish(slot->current);
+                }
+                slot->current = nullptr;
+            }
+        }
+        drain(true);
+    }
+
+    uint64_t getRecordCount() const { return sequence.load(std::memory_order_relaxed); }
+};
+
+// ============================================================================
+// Replayer - Re-applies a journal to a rebuilt graph
+// ============================================================================
+
+/**
+ * @brief Replays a journal in its original write order
+ *
+ * Rebuild the graph the same way as the recording process, bind() each
+ * key to its new source node, then replay(). Every entry goes through
+ * Yi::set, so propagation and subscribers run exactly as they did live.
+ *
+ * @example
+ * Replayer replay("graph.wal");
+ * replay.bind("bid", bid);
+ * replay.bind("ask", ask);
+ * replay.replay();
+ */
+class Replayer {
+    using Format = detail::JournalFormat;
+
+    struct Binding {
+        QinBase::SharedQinBase_T node;
+        void (*apply)(QinBase&, const char*, size_t) = nullptr;
+    };
+
+    MappedFile                                file;
+    std::unordered_map<std::string, uint32_t> ids;
+    std::vector<Binding>                      bindings;
+    std::vector<const char*>                  entries; // EntryHeader positions, in sequence order
+
+    template<class T>
+    static void applyValue(QinBase& node, const char* data, size_t size) {
+        static_cast<Yi<T, T>&>(node).set(Serializer<T>::read(data, size));
+    }
+
+    static Format::EntryHeader header(const char* at) {
+        Format::EntryHeader entry;
+        std::memcpy(&entry, at, sizeof(entry));
+        return entry;
+    }
+
+public:
+    /**
+     * @brief Map a journal and index its entries
+     * @throws std::runtime_error if the file is not a journal
+     */
+    explicit Replayer(const std::string& path)
+        : file(path) {
+        const char* base = file.data();
+        size_t      size = file.size();
+        size_t      head = sizeof(Format::Magic) + sizeof(Format::Version);
+
+        if (size < head || std::memcmp(base, Format::Magic, sizeof(Format::Magic)) != 0) {
+            throw std::runtime_error("Replayer: not a journal: " + path);
+        }
+
+        bool   sorted = true;
+        size_t offset = head;
+        while (size - offset >= sizeof(Format::RecordHeader)) {
+            Format::RecordHeader record;
+            std::memcpy(&record, base + offset, sizeof(record));
+            if (record.size > size - offset - sizeof(record)) {
+                break; // torn tail
+            }
+
+            const char* at  = base + offset + sizeof(record);
+            const char* end = at + record.size;
+            offset += sizeof(record) + record.size;
+
+            if (record.type == Format::NameRecord && record.size >= sizeof(uint32_t)) {
+                uint32_t id;
+                std::memcpy(&id, at, sizeof(id));
+                ids[std::string(at + sizeof(id), end)] = id;
+                continue;
+            }
+
+            if (record.type != Format::BlockRecord) {
+                continue;
+            }
+            while (static_cast<size_t>(end - at) >= sizeof(Format::EntryHeader)) {
+                auto entry = header(at);
+                if (entry.size > static_cast<size_t>(end - at) - sizeof(entry)) {
+                    break;
+                }
+                if (!entries.empty() && header(entries.back()).sequence > entry.sequence) {
+                    sorted = false;
+                }
+                entries.push_back(at);
+                at += sizeof(entry) + entry.size;
+            }
+        }
+
+        // Blocks from several threads interleave; restore the global order
+        if (!sorted) {
+            std::sort(entries.begin(), entries.end(), [](const char* a, const char* b) {
+                return header(a).sequence < header(b).sequence;
+            });
+        }
+
+        bindings.resize(ids.size());
+    }
+
+    /**
+     * @brief Route a journaled key to a node of the rebuilt graph
+     * @return false if the journal never recorded this key
+     */
+    template<class T>
+    bool bind(const std::string& key, const std::shared_ptr<Qin<T>>& node) {
+        auto it = ids.find(key);
+        if (it == ids.end()) {
+            return false;
+        }
+        if (it->second >= bindings.size()) {
+            bindings.resize(it->second + 1);
+        }
+        bindings[it->second] = { node, &applyValue<T> };
+        return true;
+    }
+
+    /**
+     * @brief Apply every entry of a bound key, as fast as possible
+     * @return Number of entries applied
+     */
+    size_t replay() {
+        size_t applied = 0;
+        for (auto* at : entries) {
+            auto entry = header(at);
+            if (entry.id >= bindings.size() || !bindings[entry.id].node) {
+                continue;
+            }
+            auto& binding = bindings[entry.id];
+            binding.apply(*binding.node, at + sizeof(entry), entry.size);
+            ++applied;
+        }
+        return applied;
+    }
+
+    std::vector<std::string> keys() const {
+        std::vector<std::string> names;
+        for (auto& [name, id] : ids) {
+            names.push_back(name);
+        }
+        return names;
+    }
+
+    size_t size() const { return entries.size(); }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_IO_JOURNAL_H
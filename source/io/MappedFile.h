@@ -0,0 +1,101 @@
+//
+// MappedFile - Read-only view of a whole file, memory-mapped where possible
+//
+
+#ifndef ZONGHENG_IO_MAPPEDFILE_H
+#define ZONGHENG_IO_MAPPEDFILE_H
+
+#include <cstddef>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ZONGHENG_HAS_MMAP 1
+#endif
+
+namespace ZongHeng {
+
+/**
+ * @brief Read-only bytes of a file, valid while the object lives
+ *
+ * On POSIX systems the file is mapped with mmap, so reading it costs page
+ * faults instead of a copy. Elsewhere the file is read into memory.
+ *
+ * @example
+ * MappedFile file("graph.zhs");
+ * auto* header = reinterpret_cast<const Header*>(file.data());
+ */
+class MappedFile {
+    const char*       bytes  = nullptr;
+    size_t            length = 0;
+    bool              mapped = false;
+    std::vector<char> buffer; // Fallback storage when not mapped
+
+public:
+    /**
+     * @brief Open and map a file
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit MappedFile(const std::string& path) {
+#ifdef ZONGHENG_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("MappedFile: cannot open " + path);
+        }
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("MappedFile: cannot stat " + path);
+        }
+
+        length = static_cast<size_t>(st.st_size);
+        if (length > 0) {
+            void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                bytes  = static_cast<const char*>(p);
+                mapped = true;
+            }
+        }
+        ::close(fd);
+
+        if (mapped || length == 0) {
+            return;
+        }
+#endif
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            throw std::runtime_error("MappedFile: cannot open " + path);
+        }
+        buffer.resize(static_cast<size_t>(in.tellg()));
+        in.seekg(0);
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        bytes  = buffer.data();
+        length = buffer.size();
+    }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifdef ZONGHENG_HAS_MMAP
+        if (mapped) {
+            ::munmap(const_cast<char*>(bytes), length);
+        }
+#endif
+    }
+
+    const char* data() const { return bytes; }
+    size_t      size() const { return length; }
+    bool        isMapped() const { return mapped; }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_IO_MAPPEDFILE_H
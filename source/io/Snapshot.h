@@ -0,0 +1,648 @@
+//
+// Snapshot - Save a node graph to a compact binary file and map it back
+//
+
+#ifndef ZONGHENG_IO_SNAPSHOT_H
+#define ZONGHENG_IO_SNAPSHOT_H
+
+#include "MappedFile.h"
+#include "../operations/Operators.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ZongHeng {
+
+// ============================================================================
+// Snapshot - Graph serialization
+// ============================================================================
+
+/**
+ * @brief Serialize a graph (topology, built-in operators, values) to a file
+ *
+ * A snapshot stores every node reachable upstream of the given roots in
+ * dependency order, together with the binding edges between them. Built-in
+ * operator nodes (+, -, ==, !, ...) are rebuilt from their kind; nodes made
+ * from user functions must be created through a builder registered with
+ * define(), and are rebuilt by calling that builder again by name. Values
+ * are stored as raw bytes and copied back, so derived nodes come back clean
+ * and nothing is recomputed while loading.
+ *
+ * The file is native-endian and is read through a memory mapping: loading
+ * costs the page faults for the tables plus one allocation per node.
+ *
+ * Only value types registered with registerType() can be stored; the
+ * common arithmetic types are registered by default.
+ *
+ * @example
+ * Snapshot::define("scale", [](const Snapshot::Args& in) {
+ *     return Snapshot::arg<int>(in, 0)->map([](int x) { return x * 10; });
+ * });
+ * auto price  = Qin<int>::make(3);
+ * auto scaled = Snapshot::build<int>("scale", { price });
+ * Snapshot::save("graph.zhs", { scaled + price });
+ *
+ * auto graph = Snapshot::load("graph.zhs");    // same builders defined
+ * auto total = graph.roots[0]->into<int, int>();
+ */
+class Snapshot {
+public:
+    using SharedNode_T = QinBase::SharedQinBase_T;
+    using Args         = std::vector<SharedNode_T>;
+    using Builder      = std::function<SharedNode_T(const Args&)>;
+
+    struct Graph {
+        std::vector<SharedNode_T> nodes; // File order (dependencies first)
+        std::vector<SharedNode_T> roots; // In the order given to save()
+    };
+
+private:
+    static constexpr char     Magic[4] = { 'Z', 'H', 'S', 'G' };
+    static constexpr uint32_t Version  = 1;
+
+    // On-disk layout; every table starts 8-byte aligned
+    struct Header {
+        char     magic[4];
+        uint32_t version;
+        uint32_t nodeCount;
+        uint32_t operandCount;
+        uint32_t rootCount;
+        uint32_t bindCount;
+        uint32_t typeCount;
+        uint32_t recipeCount;
+        uint64_t nodesAt;
+        uint64_t operandsAt;
+        uint64_t rootsAt;
+        uint64_t bindsAt;
+        uint64_t typesAt;
+        uint64_t recipesAt;
+        uint64_t valuesAt;
+        uint64_t size;
+    };
+
+    struct NodeRecord {
+        uint8_t  kind;
+        uint8_t  flags;        // StaleFlag: value was out of date when saved
+        uint16_t type;         // Index into the file's type table
+        uint32_t recipe;       // Index into the file's recipe table (Named)
+        uint32_t firstOperand; // Index into the operand array
+        uint32_t operandCount;
+        uint64_t value;        // Offset into the value blob
+        uint32_t valueSize;
+        uint32_t reserved;
+    };
+
+    struct BindRecord {
+        uint32_t source;
+        uint32_t target; // target mirrors source (target << source)
+    };
+
+    static constexpr uint8_t StaleFlag = 1;
+
+    struct TypeOps {
+        std::string           name;
+        const std::type_info* type;
+        size_t                size;
+        SharedNode_T (*makeSource)(const char*);
+        void (*read)(QinBase&, char*);
+        void (*write)(QinBase&, const char*);
+        SharedNode_T (*apply)(NodeKind, const SharedNode_T&, const SharedNode_T&);
+    };
+
+    struct Recipe {
+        std::string name;
+        Builder     build;
+    };
+
+    struct Registry {
+        std::vector<TypeOps>                      types;
+        std::vector<Recipe>                       recipes;
+        std::unordered_map<std::string, uint32_t> recipeIds;
+    };
+
+    // ========================================================================
+    // Per-type operations
+    // ========================================================================
+
+    template<class T>
+    static Yi<T, T>& yi(QinBase& node) {
+        return static_cast<Yi<T, T>&>(node);
+    }
+
+    template<class T>
+    static SharedNode_T makeSource(const char* bytes) {
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return Qin<T>::make(value);
+    }
+
+    template<class T>
+    static void readValue(QinBase& node, char* out) {
+        std::memcpy(out, &yi<T>(node).storage(), sizeof(T));
+    }
+
+    template<class T>
+    static void writeValue(QinBase& node, const char* bytes) {
+        std::memcpy(&yi<T>(node).rawValue, bytes, sizeof(T));
+    }
+
+    template<class T>
+    static SharedNode_T apply(NodeKind kind, const SharedNode_T& a, const SharedNode_T& b) {
+        constexpr bool arithmetic = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+        constexpr bool integral   = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+        auto p = std::static_pointer_cast<Qin<T>>(a);
+        auto q = std::static_pointer_cast<Qin<T>>(b);
+
+        switch (kind) {
+            case NodeKind::Add: if constexpr (arithmetic) { return p + q; } break;
+            case NodeKind::Sub: if constexpr (arithmetic) { return p - q; } break;
+            case NodeKind::Mul: if constexpr (arithmetic) { return p * q; } break;
+            case NodeKind::Div: if constexpr (arithmetic) { return p / q; } break;
+            case NodeKind::Mod: if constexpr (integral) { return p % q; } break;
+            case NodeKind::BitAnd: if constexpr (integral) { return p & q; } break;
+            case NodeKind::BitOr: if constexpr (integral) { return p | q; } break;
+            case NodeKind::BitXor: if constexpr (integral) { return p ^ q; } break;
+            case NodeKind::Eq: return p == q;
+            case NodeKind::Ne: return p != q;
+            case NodeKind::Lt: return p < q;
+            case NodeKind::Gt: return p > q;
+            case NodeKind::Le: return p <= q;
+            case NodeKind::Ge: return p >= q;
+            case NodeKind::Neg: if constexpr (arithmetic) { return -p; } break;
+            case NodeKind::BitNot: if constexpr (integral) { return ~p; } break;
+            case NodeKind::Not: return !p;
+            default: break;
+        }
+
+        throw std::runtime_error("Snapshot: operator not supported for this type");
+    }
+
+    static Registry& registry() {
+        static Registry r = []() {
+            Registry built;
+            addType<bool>(built, "bool");
+            addType<char>(built, "char");
+            addType<short>(built, "short");
+            addType<int>(built, "int");
+            addType<long>(built, "long");
+            addType<long long>(built, "long long");
+            addType<unsigned short>(built, "unsigned short");
+            addType<unsigned int>(built, "unsigned int");
+            addType<unsigned long>(built, "unsigned long");
+            addType<unsigned long long>(built, "unsigned long long");
+            addType<float>(built, "float");
+            addType<double>(built, "double");
+            return built;
+        }();
+        return r;
+    }
+
+    template<class T>
+    static void addType(Registry& r, const std::string& name) {
+        static_assert(std::is_trivially_copyable_v<T>, "Snapshot values are stored as raw bytes");
+
+        for (auto& ops : r.types) {
+            if (*ops.type == typeid(Yi<T, T>)) {
+                return;
+            }
+            if (ops.name == name) {
+                throw std::runtime_error("Snapshot: type name already registered: " + name);
+            }
+        }
+
+        r.types.push_back({ name, &typeid(Yi<T, T>), sizeof(T),
+                            &makeSource<T>, &readValue<T>, &writeValue<T>, &apply<T> });
+    }
+
+    static const TypeOps& typeOf(const QinBase& node) {
+        for (auto& ops : registry().types) {
+            if (*ops.type == node.nodeType()) {
+                return ops;
+            }
+        }
+        throw std::runtime_error(std::string("Snapshot: unregistered node type ") + node.nodeType().name());
+    }
+
+    static bool isBinary(NodeKind kind) {
+        return kind >= NodeKind::Add && kind <= NodeKind::Ge;
+    }
+
+    // Inputs a node is rebuilt from, in construction order
+    static std::vector<QinBase*> operandsOf(QinBase& node) {
+        switch (node.kind) {
+            case NodeKind::Constant:
+                return {};
+            case NodeKind::Source:
+                if (!node.Upstream.empty()) {
+                    throw std::runtime_error(
+                        "Snapshot: derived node without a recipe (build it with Snapshot::build)");
+                }
+                return {};
+            case NodeKind::Named:
+                return node.Operands;
+            case NodeKind::Map:
+                throw std::runtime_error(
+                    "Snapshot: derived node without a recipe (build it with Snapshot::build)");
+            default:
+                if (isBinary(node.kind)) {
+                    // lian() links a node used on both sides only once
+                    return { node.Upstream.front(), node.Upstream.back() };
+                }
+                return { node.Upstream.front() };
+        }
+    }
+
+    static void align(std::string& out) {
+        out.resize((out.size() + 7) & ~size_t(7), '\0');
+    }
+
+    template<class R>
+    static void append(std::string& out, const R& record) {
+        out.append(reinterpret_cast<const char*>(&record), sizeof(R));
+    }
+
+    static void appendStrings(std::string& out, const std::vector<std::string>& strings) {
+        for (auto& s : strings) {
+            append(out, static_cast<uint32_t>(s.size()));
+            out.append(s);
+        }
+    }
+
+    static std::vector<std::string> readStrings(const char* at, const char* end, uint32_t count) {
+        std::vector<std::string> strings;
+        strings.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t len;
+            if (end - at < static_cast<std::ptrdiff_t>(sizeof(len))) {
+                throw std::runtime_error("Snapshot: truncated string table");
+            }
+            std::memcpy(&len, at, sizeof(len));
+            at += sizeof(len);
+            if (end - at < static_cast<std::ptrdiff_t>(len)) {
+                throw std::runtime_error("Snapshot: truncated string table");
+            }
+            strings.emplace_back(at, len);
+            at += len;
+        }
+        return strings;
+    }
+
+    template<class R>
+    static const R* table(const char* base, size_t fileSize, uint64_t at, uint64_t count) {
+        if (at % alignof(R) != 0 || at > fileSize || count > (fileSize - at) / sizeof(R)) {
+            throw std::runtime_error("Snapshot: corrupt table offset");
+        }
+        return reinterpret_cast<const R*>(base + at);
+    }
+
+    static void tag(QinBase& node, uint32_t recipe, const Args& args) {
+        node.kind   = NodeKind::Named;
+        node.recipe = recipe;
+        node.Operands.clear();
+        for (auto& arg : args) {
+            node.Operands.push_back(arg.get());
+        }
+    }
+
+public:
+    // ========================================================================
+    // Registration
+    // ========================================================================
+
+    /**
+     * @brief Allow nodes of type Qin<T> to be stored in snapshots
+     * @param name Stable name written to the file (must match on load)
+     */
+    template<class T>
+    static void registerType(const std::string& name) {
+        addType<T>(registry(), name);
+    }
+
+    /**
+     * @brief Register a named builder for nodes made from user functions
+     *
+     * The builder receives the operand nodes and returns the new node. It
+     * runs again with the restored operands when a snapshot is loaded.
+     */
+    static void define(const std::string& name, Builder builder) {
+        auto& r  = registry();
+        auto  it = r.recipeIds.find(name);
+        if (it != r.recipeIds.end()) {
+            r.recipes[it->second].build = std::move(builder);
+            return;
+        }
+        r.recipeIds.emplace(name, static_cast<uint32_t>(r.recipes.size()));
+        r.recipes.push_back({ name, std::move(builder) });
+    }
+
+    /**
+     * @brief Operand i of a builder as Qin<T>
+     * @throws std::runtime_error if the operand has another type
+     */
+    template<class T>
+    static std::shared_ptr<Qin<T>> arg(const Args& args, size_t i) {
+        if (i >= args.size() || !args[i]->template isA<T, T>()) {
+            throw std::runtime_error("Snapshot: builder operand has another type");
+        }
+        return std::static_pointer_cast<Qin<T>>(args[i]);
+    }
+
+    /**
+     * @brief Create a node through a registered builder so it can be saved
+     * @throws std::runtime_error if the name is unknown or the type differs
+     * @example auto scaled = Snapshot::build<int>("scale", { price });
+     */
+    template<class T>
+    static std::shared_ptr<Qin<T>> build(const std::string& name, const Args& args) {
+        auto& r  = registry();
+        auto  it = r.recipeIds.find(name);
+        if (it == r.recipeIds.end()) {
+            throw std::runtime_error("Snapshot: unknown builder " + name);
+        }
+
+        auto node = r.recipes[it->second].build(args);
+        if (!node->template isA<T, T>()) {
+            throw std::runtime_error("Snapshot: builder " + name + " returned another node type");
+        }
+        tag(*node, it->second, args);
+        return std::static_pointer_cast<Qin<T>>(node);
+    }
+
+    // ========================================================================
+    // Save / Load
+    // ========================================================================
+
+    /**
+     * @brief Write every node upstream of roots (and bindings between them)
+     * @throws std::runtime_error for nodes that cannot be rebuilt (user
+     *         lambdas not made through build(), stateful nodes) or values
+     *         of unregistered types
+     */
+    static void save(const std::string& path, const std::vector<SharedNode_T>& roots) {
+        // Dependency-ordered walk (iterative: graphs can be very deep)
+        std::unordered_map<const QinBase*, uint32_t> index;
+        std::vector<QinBase*>                        order;
+        std::vector<std::pair<QinBase*, bool>>       stack;
+
+        for (auto it = roots.rbegin(); it != roots.rend(); ++it) {
+            stack.emplace_back(it->get(), false);
+        }
+        while (!stack.empty()) {
+            auto [node, expanded] = stack.back();
+            stack.pop_back();
+            if (index.count(node)) {
+                continue;
+            }
+            if (expanded) {
+                index.emplace(node, static_cast<uint32_t>(order.size()));
+                order.push_back(node);
+                continue;
+            }
+            stack.emplace_back(node, true);
+            auto operands = operandsOf(*node);
+            for (auto op = operands.rbegin(); op != operands.rend(); ++op) {
+                if (!index.count(*op)) {
+                    stack.emplace_back(*op, false);
+                }
+            }
+        }
+
+        std::vector<NodeRecord>                        nodes;
+        std::vector<uint32_t>                          operands;
+        std::vector<BindRecord>                        binds;
+        std::vector<std::string>                       typeNames;
+        std::vector<std::string>                       recipeNames;
+        std::unordered_map<std::type_index, uint16_t>  typeIds;
+        std::unordered_map<uint32_t, uint32_t>         recipeIds;
+        std::string                                    values;
+
+        nodes.reserve(order.size());
+        for (auto* node : order) {
+            auto& ops = typeOf(*node);
+
+            NodeRecord rec {};
+            rec.kind  = static_cast<uint8_t>(node->kind);
+            rec.flags = node->dirty ? StaleFlag : 0;
+
+            auto type = typeIds.emplace(std::type_index(*ops.type), static_cast<uint16_t>(typeNames.size()));
+            if (type.second) {
+                typeNames.push_back(ops.name);
+            }
+            rec.type = type.first->second;
+
+            if (node->kind == NodeKind::Named) {
+                auto recipe = recipeIds.emplace(node->recipe, static_cast<uint32_t>(recipeNames.size()));
+                if (recipe.second) {
+                    recipeNames.push_back(registry().recipes[node->recipe].name);
+                }
+                rec.recipe = recipe.first->second;
+            }
+
+            rec.firstOperand = static_cast<uint32_t>(operands.size());
+            for (auto* op : operandsOf(*node)) {
+                auto found = index.find(op);
+                if (found == index.end() || found->second >= nodes.size()) {
+                    throw std::runtime_error("Snapshot: dependency cycle");
+                }
+                operands.push_back(found->second);
+            }
+            rec.operandCount = static_cast<uint32_t>(operands.size()) - rec.firstOperand;
+
+            align(values);
+            rec.value     = values.size();
+            rec.valueSize = static_cast<uint32_t>(ops.size);
+            values.resize(values.size() + ops.size);
+            ops.read(*node, &values[rec.value]);
+
+            nodes.push_back(rec);
+        }
+
+        for (auto* node : order) {
+            for (auto& target : node->Zong) {
+                auto found = index.find(target.get());
+                if (found != index.end()) {
+                    binds.push_back({ index[node], found->second });
+                }
+            }
+        }
+
+        std::vector<uint32_t> rootIds;
+        for (auto& root : roots) {
+            rootIds.push_back(index[root.get()]);
+        }
+
+        // Layout: header, node records, operands, roots, binds, names, values
+        std::string out(sizeof(Header), '\0');
+        Header      header {};
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.version      = Version;
+        header.nodeCount    = static_cast<uint32_t>(nodes.size());
+        header.operandCount = static_cast<uint32_t>(operands.size());
+        header.rootCount    = static_cast<uint32_t>(rootIds.size());
+        header.bindCount    = static_cast<uint32_t>(binds.size());
+        header.typeCount    = static_cast<uint32_t>(typeNames.size());
+        header.recipeCount  = static_cast<uint32_t>(recipeNames.size());
+
+        align(out);
+        header.nodesAt = out.size();
+        for (auto& rec : nodes) append(out, rec);
+        align(out);
+        header.operandsAt = out.size();
+        for (auto id : operands) append(out, id);
+        align(out);
+        header.rootsAt = out.size();
+        for (auto id : rootIds) append(out, id);
+        align(out);
+        header.bindsAt = out.size();
+        for (auto& bind : binds) append(out, bind);
+        align(out);
+        header.typesAt = out.size();
+        appendStrings(out, typeNames);
+        align(out);
+        header.recipesAt = out.size();
+        appendStrings(out, recipeNames);
+        align(out);
+        header.valuesAt = out.size();
+        out.append(values);
+        header.size = out.size();
+
+        std::memcpy(&out[0], &header, sizeof(Header));
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+            throw std::runtime_error("Snapshot: cannot write " + path);
+        }
+    }
+
+    /**
+     * @brief Rebuild a graph saved with save()
+     *
+     * Builders referenced by the file must be defined before loading.
+     * Values are copied from the mapping; no node recomputes.
+     *
+     * @throws std::runtime_error if the file is corrupt or references an
+     *         unknown type or builder
+     */
+    static Graph load(const std::string& path) {
+        MappedFile  file(path);
+        const char* base = file.data();
+        size_t      size = file.size();
+
+        if (size < sizeof(Header)) {
+            throw std::runtime_error("Snapshot: file too small");
+        }
+        const auto& header = *reinterpret_cast<const Header*>(base);
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version
+            || header.size != size) {
+            throw std::runtime_error("Snapshot: not a snapshot file (or wrong version)");
+        }
+
+        auto* records  = table<NodeRecord>(base, size, header.nodesAt, header.nodeCount);
+        auto* operands = table<uint32_t>(base, size, header.operandsAt, header.operandCount);
+        auto* rootIds  = table<uint32_t>(base, size, header.rootsAt, header.rootCount);
+        auto* binds    = table<BindRecord>(base, size, header.bindsAt, header.bindCount);
+        auto* values   = table<char>(base, size, header.valuesAt, 0);
+
+        auto& r = registry();
+
+        // Fix-up: file-local type and recipe ids -> registered entries
+        std::vector<const TypeOps*> types;
+        for (auto& name : readStrings(base + header.typesAt, base + size, header.typeCount)) {
+            auto it = std::find_if(r.types.begin(), r.types.end(),
+                                   [&name](const TypeOps& ops) { return ops.name == name; });
+            if (it == r.types.end()) {
+                throw std::runtime_error("Snapshot: unregistered type " + name);
+            }
+            types.push_back(&*it);
+        }
+
+        std::vector<uint32_t> recipes;
+        for (auto& name : readStrings(base + header.recipesAt, base + size, header.recipeCount)) {
+            auto it = r.recipeIds.find(name);
+            if (it == r.recipeIds.end()) {
+                throw std::runtime_error("Snapshot: unknown builder " + name);
+            }
+            recipes.push_back(it->second);
+        }
+
+        Graph graph;
+        graph.nodes.reserve(header.nodeCount);
+
+        for (uint32_t i = 0; i < header.nodeCount; ++i) {
+            const auto& rec = records[i];
+            if (rec.type >= types.size() || rec.firstOperand > header.operandCount
+                || rec.operandCount > header.operandCount - rec.firstOperand
+                || rec.value > size - header.valuesAt
+                || rec.valueSize != types[rec.type]->size
+                || rec.valueSize > size - header.valuesAt - rec.value) {
+                throw std::runtime_error("Snapshot: corrupt node record");
+            }
+
+            std::vector<SharedNode_T> args;
+            for (uint32_t k = 0; k < rec.operandCount; ++k) {
+                auto id = operands[rec.firstOperand + k];
+                if (id >= i) {
+                    throw std::runtime_error("Snapshot: operand out of order");
+                }
+                args.push_back(graph.nodes[id]);
+            }
+
+            auto&        ops   = *types[rec.type];
+            auto         kind  = static_cast<NodeKind>(rec.kind);
+            const char*  value = values + rec.value;
+            SharedNode_T node;
+
+            if (kind == NodeKind::Source) {
+                node = ops.makeSource(value);
+            } else if (kind == NodeKind::Constant) {
+                node       = ops.makeSource(value);
+                node->kind = NodeKind::Constant;
+            } else if (kind == NodeKind::Named) {
+                if (rec.recipe >= recipes.size()) {
+                    throw std::runtime_error("Snapshot: corrupt node record");
+                }
+                node = r.recipes[recipes[rec.recipe]].build(args);
+                tag(*node, recipes[rec.recipe], args);
+            } else if (kind <= NodeKind::Not && !args.empty()) {
+                const auto& lhs = records[operands[rec.firstOperand]];
+                node = types[lhs.type]->apply(kind, args.front(), args.back());
+            } else {
+                throw std::runtime_error("Snapshot: corrupt node record");
+            }
+
+            if (node->nodeType() != *ops.type) {
+                throw std::runtime_error("Snapshot: rebuilt node has another type than saved");
+            }
+
+            ops.write(*node, value);
+            node->dirty = (rec.flags & StaleFlag) != 0;
+            graph.nodes.push_back(std::move(node));
+        }
+
+        for (uint32_t i = 0; i < header.bindCount; ++i) {
+            if (binds[i].source >= header.nodeCount || binds[i].target >= header.nodeCount) {
+                throw std::runtime_error("Snapshot: corrupt binding record");
+            }
+            graph.nodes[binds[i].target]->bind(graph.nodes[binds[i].source]);
+        }
+
+        for (uint32_t i = 0; i < header.rootCount; ++i) {
+            if (rootIds[i] >= header.nodeCount) {
+                throw std::runtime_error("Snapshot: corrupt root record");
+            }
+            graph.roots.push_back(graph.nodes[rootIds[i]]);
+        }
+
+        return graph;
+    }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_IO_SNAPSHOT_H
@@ -0,0 +1,102 @@
+//
+// Computed node - derived value with automatically captured dependencies
+//
+
+#ifndef ZONGHENG_NODES_COMPUTED_H
+#define ZONGHENG_NODES_COMPUTED_H
+
+#include "Qin.h"
+
+namespace ZongHeng {
+
+// ============================================================================
+// ComputedNode - Upstream edges follow the nodes the function reads
+// ============================================================================
+
+/**
+ * @brief Node whose upstream edges are the nodes its function last read
+ *
+ * Every evaluation runs the function under a DependencyScope, so each
+ * get()/peek() it makes is recorded. When the recorded set differs from
+ * the current upstream edges the node is rewired: new reads are connected,
+ * nodes no longer read are disconnected. Edges are only touched when the
+ * set changes, and the edit is deferred to the end of the propagation pass
+ * when one is running.
+ */
+template<class T, class Fn>
+class ComputedNode : public Qin<T> {
+public:
+    using SharedComputed_T = std::shared_ptr<ComputedNode<T, Fn>>;
+
+private:
+    Fn                    fn;
+    std::vector<QinBase*> deps; // Reads of the last evaluation (scratch)
+
+    T evaluate() {
+        deps.clear();
+        T value = [this]() {
+            detail::DependencyScope scope(&deps);
+            return fn();
+        }();
+
+        if (!sameDeps()) {
+            Batch::defer([node = this->self, wanted = deps]() {
+                static_cast<ComputedNode&>(*node).rewire(wanted);
+            });
+        }
+        return value;
+    }
+
+    bool sameDeps() const {
+        auto& ups = this->Upstream;
+        if (deps.size() != ups.size()) {
+            return false;
+        }
+        for (auto* dep : deps) {
+            if (std::find(ups.begin(), ups.end(), dep) == ups.end()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    explicit ComputedNode(Fn f)
+        : fn(std::move(f)) { }
+
+    static SharedComputed_T make(Fn f) {
+        auto ptr     = std::make_shared<ComputedNode<T, Fn>>(std::move(f));
+        ptr->self    = ptr;
+        ptr->rewires = true;
+        ptr->setEff([raw = ptr.get()]() -> T {
+            return raw->evaluate();
+        });
+        ptr->get(); // first evaluation wires the initial dependencies
+        return ptr;
+    }
+};
+
+/**
+ * @brief Derived node whose dependencies are discovered by running fn
+ *
+ * Any node fn reads with get() or peek() becomes an upstream edge; reads
+ * that stop happening (e.g. the untaken side of a conditional) drop their
+ * edge on the next evaluation. No manual lian/addDerivedNode wiring.
+ *
+ * @param fn Function of no arguments reading other nodes
+ * @return New Qin node holding fn's result
+ *
+ * @example
+ * auto total = computed([a, b, useB]() {
+ *     return useB->get() ? a->get() + b->get() : a->get();
+ * });
+ */
+template<class Fn>
+auto computed(Fn fn) -> std::shared_ptr<Qin<std::decay_t<std::invoke_result_t<Fn&>>>> {
+    using R = std::decay_t<std::invoke_result_t<Fn&>>;
+    return ComputedNode<R, Fn>::make(std::move(fn));
+}
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_NODES_COMPUTED_H
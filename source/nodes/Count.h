@@ -0,0 +1,124 @@
+//
+// Count nodes - countIf / all / any over many inputs, updated incrementally
+//
+
+#ifndef ZONGHENG_NODES_COUNT_H
+#define ZONGHENG_NODES_COUNT_H
+
+#include "Qin.h"
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+namespace ZongHeng {
+
+/**
+ * @brief What a CountNode publishes from its count of matching inputs
+ */
+enum class CountMode : uint8_t {
+    Count, // size_t: number of matching inputs
+    All,   // bool: every input matches
+    Any    // bool: at least one input matches
+};
+
+// ============================================================================
+// CountNode - Running count of inputs satisfying a predicate
+// ============================================================================
+
+/**
+ * @brief Keeps the number of inputs for which pred(value) holds
+ *
+ * Each input's last predicate result is cached. When an input changes,
+ * only its own slot is re-evaluated and the count adjusted, so a change
+ * costs O(1) regardless of the number of inputs, and the result is
+ * forwarded only when it actually changes (an All/Any node stays quiet
+ * until the count crosses its threshold).
+ */
+template<class T, class Pred, CountMode Mode>
+class CountNode : public Qin<std::conditional_t<Mode == CountMode::Count, size_t, bool>> {
+public:
+    using Result_T      = std::conditional_t<Mode == CountMode::Count, size_t, bool>;
+    using SharedCount_T = std::shared_ptr<CountNode<T, Pred, Mode>>;
+    using Source_T      = std::shared_ptr<Qin<T>>;
+
+private:
+    std::vector<Source_T>                     inputs;
+    std::vector<uint8_t>                      matched; // pred result per input
+    std::unordered_multimap<QinBase*, size_t> slots;   // input node -> its indices
+    Pred                                      pred;
+    size_t                                    count = 0;
+
+    Result_T result() const {
+        if constexpr (Mode == CountMode::Count) {
+            return count;
+        } else if constexpr (Mode == CountMode::All) {
+            return count == inputs.size();
+        } else {
+            return count > 0;
+        }
+    }
+
+    void update(size_t i) {
+        bool now = static_cast<bool>(pred(inputs[i]->peek()));
+        if (now != static_cast<bool>(matched[i])) {
+            matched[i] = now;
+            now ? ++count : --count;
+        }
+    }
+
+    void publish() {
+        auto next = result();
+        if (next != this->storage()) {
+            this->set(next);
+        }
+    }
+
+protected:
+    void refreshFrom(QinBase& upstream) override {
+        auto range = slots.equal_range(&upstream);
+        for (auto it = range.first; it != range.second; ++it) {
+            update(it->second);
+        }
+        publish();
+    }
+
+    // Upstream unknown: rescan every input
+    void refresh() override {
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            update(i);
+        }
+        publish();
+    }
+
+public:
+    CountNode(std::vector<Source_T> sources, Pred p)
+        : inputs(std::move(sources))
+        , matched(inputs.size(), 0)
+        , pred(std::move(p)) {
+        slots.reserve(inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            slots.emplace(inputs[i].get(), i);
+            update(i);
+        }
+        this->set_raw(result());
+    }
+
+    size_t getCount() const { return count; }
+
+    static SharedCount_T make(std::vector<Source_T> sources, Pred p) {
+        auto ptr  = std::make_shared<CountNode<T, Pred, Mode>>(std::move(sources), std::move(p));
+        ptr->self = ptr;
+        for (auto& input : ptr->inputs) {
+            auto& ups = ptr->Upstream;
+            if (std::find(ups.begin(), ups.end(), input.get()) == ups.end()) {
+                QinBase::connect(input, ptr);
+            }
+        }
+        ptr->retain(); // stateful: must see every upstream change
+        return ptr;
+    }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_NODES_COUNT_H
@@ -0,0 +1,127 @@
+//
+// Map node - map() chains fused into one propagation step
+//
+
+#ifndef ZONGHENG_NODES_MAP_H
+#define ZONGHENG_NODES_MAP_H
+
+#include "Qin.h"
+#include <algorithm>
+
+namespace ZongHeng {
+
+// ============================================================================
+// MapNode - Result of map(), composed with the maps it is built on
+// ============================================================================
+
+/**
+ * @brief Node computing fn(source) where source may itself be a map() chain
+ *
+ * map() on a MapNode does not hang the new node off it: the new node is
+ * derived directly from the chain's source and its effect pulls the value
+ * through each stage's function. If the stage it was built on has no
+ * observers, subscribers, derived nodes or hooks, that stage is
+ * disconnected, so `v->map(f1)->map(f2)->map(f3)` costs one edge and one
+ * recompute per write of v instead of three.
+ *
+ * Intermediate stages stay valid handles. A detached stage recomputes its
+ * chain on each read; it reconnects to the source (and caches again) as
+ * soon as it is observed or something is derived from it. A stage that is
+ * connected and clean is read from its cache instead of being recomputed.
+ */
+template<class T>
+class MapNode : public Qin<T> {
+public:
+    using SharedMap_T = std::shared_ptr<MapNode<T>>;
+
+private:
+    QinBase::SharedQinBase_T       source; // Start of the chain
+    ZongHeng::InplaceFunction<T()> pull;   // fn(stage below), bypassing this node's cache
+
+    // Stage value for the next stage: cached when valid, pulled otherwise
+    T through() {
+        if (this->_getter || this->_setter || (!this->dirty && !this->Upstream.empty())) {
+            return this->get();
+        }
+        return pull();
+    }
+
+    // Nothing but the next stage would notice this node leaving the source
+    bool detachable() const {
+        return this->observers == 0 && this->Subscribers.empty() && this->getHengCount() == 0
+            && this->Zong.empty() && !this->writeHook && !this->_getter && !this->_setter;
+    }
+
+    template<class Pull>
+    static SharedMap_T make(QinBase::SharedQinBase_T source, Pull pull) {
+        auto node    = std::make_shared<MapNode<T>>();
+        node->self   = node;
+        node->kind   = NodeKind::Map;
+        node->source = source;
+        node->pull   = ZongHeng::fitInline(std::move(pull));
+        node->QinBase::lian(source, source);
+        node->setEff([raw = node.get()]() -> T {
+            return raw->pull();
+        });
+        return node;
+    }
+
+protected:
+    void attach() override {
+        if (this->Upstream.empty() && !this->isDisposed()) {
+            this->dirty = true;
+            QinBase::connect(source, this->self);
+
+            // Refresh before the later stages that read through this one
+            auto& hengs = source->Heng;
+            std::rotate(hengs.begin(), hengs.end() - 1, hengs.end());
+            source->reslotHeng();
+        }
+    }
+
+    void activate() override {
+        attach();
+        Yi<T, T>::activate();
+    }
+
+public:
+    // Whether this stage currently caches (connected to the chain's source)
+    bool isAttached() const { return !this->Upstream.empty(); }
+
+    /**
+     * @brief map() on a node: starts a chain, or extends one it ends
+     * @param stage Node the function is applied to
+     * @param fn Transformation function (IN -> T)
+     * @return New MapNode derived from the chain's source
+     */
+    template<class IN, class Fn>
+    static SharedMap_T chain(Qin<IN>& stage, Fn fn) {
+        if (stage.getKind() != NodeKind::Map) {
+            auto src = stage.template into<IN, IN>();
+            return make(src, [src, fn]() -> T {
+                return fn(src->get());
+            });
+        }
+
+        auto& below = static_cast<MapNode<IN>&>(stage);
+        auto  prev  = std::static_pointer_cast<MapNode<IN>>(below.self);
+        auto  node  = make(below.source, [prev, fn]() -> T {
+            return fn(prev->through());
+        });
+        if (below.isAttached() && below.detachable()) {
+            Batch::defer([prev]() {
+                if (prev->isAttached() && prev->detachable()) {
+                    prev->disconnect(prev->Upstream.front());
+                }
+            });
+        }
+        return node;
+    }
+
+    template<class U>
+    friend class MapNode;
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_NODES_MAP_H
@@ -6,50 +6,77 @@
 #define ZONGHENG_NODES_QIN_H
 
 #include "Yi.h"
+#include "../core/TimerWheel.h"
+#include "../core/ExprTable.h"
 
 // ============================================================================
 // Qin - Homogeneous Node Template
 // ============================================================================
 
 template<class T>
-class Qin : public Yi<T, T> {
+class Qin<T, void> : public Yi<T, T> {
 public:
     using SharedQin_T = std::shared_ptr<Qin<T>>;
 
     using Yi<T, T>::operator=;
 
-    // Arithmetic operators
+    // Arithmetic operators (each result is a Qin<T, Fn> with the functor inlined)
     friend SharedQin_T operator+(SharedQin_T p, SharedQin_T q) {
-        return p->template lian<std::plus<T>>(q);
+        return binary<std::plus<T>>(std::move(p), std::move(q), ZongHeng::NodeKind::Add);
     }
 
     friend SharedQin_T operator-(SharedQin_T p, SharedQin_T q) {
-        return p->template lian<std::minus<T>>(q);
+        return binary<std::minus<T>>(std::move(p), std::move(q), ZongHeng::NodeKind::Sub);
     }
 
     friend SharedQin_T operator*(SharedQin_T p, SharedQin_T q) {
-        return p->template lian<std::multiplies<T>>(q);
+        return binary<std::multiplies<T>>(std::move(p), std::move(q), ZongHeng::NodeKind::Mul);
     }
 
     friend SharedQin_T operator/(SharedQin_T p, SharedQin_T q) {
-        return p->template lian<std::divides<T>>(q);
+        return binary<std::divides<T>>(std::move(p), std::move(q), ZongHeng::NodeKind::Div);
     }
 
     friend SharedQin_T operator%(SharedQin_T p, SharedQin_T q) {
-        return p->template lian<std::modulus<T>>(q);
+        return binary<std::modulus<T>>(std::move(p), std::move(q), ZongHeng::NodeKind::Mod);
     }
 
     // Bitwise operators
     friend SharedQin_T operator&(SharedQin_T p, SharedQin_T q) {
-        return p->template lian<std::bit_and<T>>(q);
+        return binary<std::bit_and<T>>(std::move(p), std::move(q), ZongHeng::NodeKind::BitAnd);
     }
 
     friend SharedQin_T operator|(SharedQin_T p, SharedQin_T q) {
-        return p->template lian<std::bit_or<T>>(q);
+        return binary<std::bit_or<T>>(std::move(p), std::move(q), ZongHeng::NodeKind::BitOr);
     }
 
     friend SharedQin_T operator^(SharedQin_T p, SharedQin_T q) {
-        return p->template lian<std::bit_xor<T>>(q);
+        return binary<std::bit_xor<T>>(std::move(p), std::move(q), ZongHeng::NodeKind::BitXor);
+    }
+
+    // Record which built-in operator produced node (for snapshots)
+    static SharedQin_T tagged(SharedQin_T node, ZongHeng::NodeKind kind) {
+        node->kind = kind;
+        return node;
+    }
+
+    // Build (or, with ExprTable enabled, reuse) the node for p `kind` q
+    template<class Fn>
+    static SharedQin_T binary(SharedQin_T p, SharedQin_T q, ZongHeng::NodeKind kind) {
+        if (p->isConstant() && q->isConstant()) {
+            return constant(Fn()(p->peek(), q->peek())); // folded at construction
+        }
+        return ZongHeng::ExprTable::global().template intern<T>(kind, *p, *q, commutes(kind), [&]() {
+            return tagged(Qin<T, Fn>::make(p, q), kind);
+        });
+    }
+
+    // Operand order is irrelevant (string + is not: only arithmetic types)
+    static bool commutes(ZongHeng::NodeKind kind) {
+        using ZongHeng::NodeKind;
+        return std::is_arithmetic_v<T>
+            && (kind == NodeKind::Add || kind == NodeKind::Mul || kind == NodeKind::BitAnd
+                || kind == NodeKind::BitOr || kind == NodeKind::BitXor);
     }
 
     template<class Fn>
@@ -65,7 +92,7 @@ public:
         auto new_qin = Qin<T>::make(T {});
         new_qin->QinBase::lian(this->self, q);
         new_qin->setEff([this, q]() -> T {
-            return Fn()(this->get(), q->template into<T, T>()->get());
+            return Fn()(this->get(), q->template into_ref<T, T>().get());
         });
         return new_qin;
     }
@@ -76,6 +103,11 @@ public:
 
     /**
      * @brief Map this node's value through a transformation function
+     *
+     * Consecutive map() calls are fused: the result is derived from the
+     * start of the chain and applies every stage in one recompute (see
+     * MapNode).
+     *
      * @param fn Transformation function (T -> OUT)
      * @return New Qin node with transformed value
      * @example auto doubled = nums->map([](int x) { return x * 2; });
@@ -83,12 +115,7 @@ public:
     template<class Fn>
     auto map(Fn fn) -> std::shared_ptr<Qin<decltype(fn(std::declval<T>()))>> {
         using OUT = decltype(fn(std::declval<T>()));
-        auto result = Qin<OUT>::make(OUT{});
-        result->QinBase::lian(this->self, this->self);
-        result->setEff([self = this->self, fn]() -> OUT {
-            return fn(self->template into<T, T>()->get());
-        });
-        return result;
+        return ZongHeng::MapNode<OUT>::chain(*this, std::move(fn));
     }
 
     /**
@@ -103,8 +130,9 @@ public:
         auto result = Qin<T>::make(T{});
         result->QinBase::lian(this->self, defaultVal);
         result->setEff([self = this->self, defaultVal, predicate]() -> T {
-            return predicate(self->template into<T, T>()->get())
-                ? self->template into<T, T>()->get()
+            auto& source = self->template into_ref<T, T>();
+            return predicate(source.get())
+                ? source.get()
                 : defaultVal->get();
         });
         return result;
@@ -112,23 +140,90 @@ public:
 
     /**
      * @brief Conditionally select between this value and another
+     *
+     * Only the condition and the branch it currently selects are upstream
+     * edges (see ComputedNode): writes to the other branch do not recompute
+     * the result, and that branch stays cold. Edges move on condition flips.
+     *
      * @param condition Boolean Qin node
      * @param falseVal Value to use when condition is false
      * @return New Qin node with selected value
      * @example auto selected = optionA->when(flag, optionB);
      */
     SharedQin_T when(std::shared_ptr<Qin<bool>> condition, SharedQin_T falseVal) {
-        auto result = Qin<T>::make(T{});
-        result->QinBase::lian(condition, condition);
-        this->addDerivedNode(result);
-        falseVal->addDerivedNode(result);
-
-        result->setEff([self = this->self, condition, falseVal]() -> T {
+        auto pick = [self = this->self, condition, falseVal]() -> T {
             return condition->get()
-                ? self->template into<T, T>()->get()
+                ? self->template into_ref<T, T>().get()
                 : falseVal->get();
-        });
-        return result;
+        };
+        return ZongHeng::ComputedNode<T, decltype(pick)>::make(std::move(pick));
+    }
+
+    // ========================================================================
+    // Time-based Combinators (Chainable)
+    // ========================================================================
+
+    /**
+     * @brief Forward changes at most once per interval (leading + trailing)
+     * @param interval Minimum time between two downstream updates
+     * @param scheduler Clock and timer wheel driving the trailing update
+     * @return New Qin node updated at a bounded rate
+     * @example auto slow = ticks->throttle(std::chrono::milliseconds(100));
+     */
+    SharedQin_T throttle(ZongHeng::Clock::duration            interval,
+                         std::shared_ptr<ZongHeng::Scheduler> scheduler = ZongHeng::Scheduler::global()) {
+        return ZongHeng::ThrottleNode<T>::make(this->template into<T, T>(), interval, std::move(scheduler));
+    }
+
+    /**
+     * @brief Forward the latest value once changes stop for an interval
+     * @param interval Quiet period required before forwarding
+     * @param scheduler Clock and timer wheel driving the update
+     * @return New Qin node updated after each burst settles
+     * @example auto settled = input->debounce(std::chrono::milliseconds(300));
+     */
+    SharedQin_T debounce(ZongHeng::Clock::duration            interval,
+                         std::shared_ptr<ZongHeng::Scheduler> scheduler = ZongHeng::Scheduler::global()) {
+        return ZongHeng::DebounceNode<T>::make(this->template into<T, T>(), interval, std::move(scheduler));
+    }
+
+    /**
+     * @brief Capture this node's value whenever a trigger node changes
+     * @param trigger Any node; each change of it latches the current value
+     * @return New Qin node that only updates on trigger changes
+     * @example auto snapshot = price->sample(frameTick);
+     */
+    SharedQin_T sample(std::shared_ptr<QinBase> trigger) {
+        return ZongHeng::SampleNode<T>::make(this->template into<T, T>(), trigger);
+    }
+
+    // ========================================================================
+    // Windowed Aggregations (Chainable)
+    // ========================================================================
+
+    /**
+     * @brief Rolling statistics over the last n values of this node
+     * @param n Window length in samples (storage is allocated once)
+     * @return New node holding count/sum/mean/variance/min/max
+     * @example auto avg = price->window(20)->map([](const auto& s) { return s.mean; });
+     */
+    auto window(size_t n) -> std::shared_ptr<Qin<ZongHeng::WindowStats<T>>> {
+        return ZongHeng::WindowNode<T>::make(this->template into<T, T>(), n);
+    }
+
+    /**
+     * @brief Rolling statistics over the values seen in the last time span
+     * @param span Age after which a sample leaves the window
+     * @param scheduler Clock used to stamp samples and expire them
+     * @param capacityHint Initial ring buffer size (grows if exceeded)
+     * @return New node holding count/sum/mean/variance/min/max
+     * @example auto recent = ticks->windowTime(std::chrono::seconds(5));
+     */
+    auto windowTime(ZongHeng::Clock::duration            span,
+                    std::shared_ptr<ZongHeng::Scheduler> scheduler    = ZongHeng::Scheduler::global(),
+                    size_t                               capacityHint = 64)
+        -> std::shared_ptr<Qin<ZongHeng::WindowStats<T>>> {
+        return ZongHeng::TimeWindowNode<T>::make(this->template into<T, T>(), span, std::move(scheduler), capacityHint);
     }
 
     // Factory method
@@ -138,6 +233,109 @@ public:
         ptr->self = ptr;
         return ptr;
     }
+
+    /**
+     * @brief Immutable node holding value (see ZongHeng::constant)
+     *
+     * Writes throw. Operators fold when every operand is constant, and
+     * binary operators read a constant operand once at construction
+     * instead of keeping a Heng edge to it.
+     */
+    static SharedQin_T constant(T value) {
+        auto ptr  = make(std::move(value));
+        ptr->kind = ZongHeng::NodeKind::Constant;
+        return ptr;
+    }
 };
 
+// ============================================================================
+// Qin<T, Fn> - Binary Node with a Compile-Time Effect
+// ============================================================================
+
+/**
+ * @brief Binary node whose combining functor is a template parameter
+ *
+ * Built-in operators know their functor type (std::plus<T>, ...) at compile
+ * time. Storing it by value lets the recompute thunk call it directly, so
+ * the functor and both operand reads are inlined into one function; the
+ * only indirection left is the effect thunk and QinBase's virtuals.
+ *
+ * A Qin<T, Fn> is a Qin<T>, so it is accepted anywhere a Qin<T> handle is.
+ *
+ * @example auto sum = Qin<int, std::plus<int>>::make(a, b);  // what a + b builds
+ */
+template<class T, class Fn>
+class Qin : public Qin<T> {
+public:
+    using SharedQin_T = std::shared_ptr<Qin<T>>;
+    using SharedOp_T  = std::shared_ptr<Qin<T, Fn>>;
+
+    using Yi<T, T>::operator=;
+
+    explicit Qin(Fn op)
+        : op(std::move(op)) { }
+
+    /**
+     * @brief Create a node computing op(lhs, rhs)
+     * @param lhs Left operand
+     * @param rhs Right operand
+     * @param op Combining functor
+     * @return New derived node
+     */
+    static SharedOp_T make(SharedQin_T lhs, SharedQin_T rhs, Fn op = Fn {}) {
+        auto node  = std::make_shared<Qin<T, Fn>>(std::move(op));
+        node->self = node;
+
+        // Scalar kernels: a constant operand is read once and never
+        // refreshes the node, so it is an Upstream entry without a Heng edge
+        if (rhs->isConstant() && !lhs->isConstant()) {
+            QinBase::connect(lhs, node);
+            node->Upstream.push_back(rhs.get());
+            node->setEff([raw = node.get(), k = rhs->peek()]() -> T {
+                return raw->op(raw->lhs->peek(), k);
+            });
+        } else if (lhs->isConstant() && !rhs->isConstant()) {
+            QinBase::connect(rhs, node);
+            node->Upstream.insert(node->Upstream.begin(), lhs.get());
+            node->setEff([raw = node.get(), k = lhs->peek()]() -> T {
+                return raw->op(k, raw->rhs->peek());
+            });
+        } else {
+            node->QinBase::lian(lhs, rhs);
+            node->setEff([raw = node.get()]() -> T {
+                return raw->op(raw->lhs->peek(), raw->rhs->peek());
+            });
+        }
+
+        node->lhs = std::move(lhs);
+        node->rhs = std::move(rhs);
+        return node;
+    }
+
+private:
+    Fn          op;
+    SharedQin_T lhs;
+    SharedQin_T rhs;
+};
+
+namespace ZongHeng {
+
+/**
+ * @brief Immutable node holding value
+ *
+ * Use for literals in formulas: `price * constant(2)` multiplies by a value
+ * captured at construction instead of re-reading a mutable source, and
+ * expressions whose operands are all constant are folded into a constant.
+ *
+ * @param value Value of the node
+ * @return Qin node that throws on write
+ * @example auto total = qty * ZongHeng::constant(2.5) + ZongHeng::constant(1.0);
+ */
+template<class T>
+std::shared_ptr<Qin<T>> constant(T value) {
+    return Qin<T>::constant(std::move(value));
+}
+
+} // namespace ZongHeng
+
 #endif // ZONGHENG_NODES_QIN_H
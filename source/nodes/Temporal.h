@@ -0,0 +1,200 @@
+//
+// Temporal nodes - throttle / debounce / sample
+//
+
+#ifndef ZONGHENG_NODES_TEMPORAL_H
+#define ZONGHENG_NODES_TEMPORAL_H
+
+#include "Qin.h"
+
+namespace ZongHeng {
+
+// ============================================================================
+// ThrottleNode - At most one forwarded update per interval
+// ============================================================================
+
+/**
+ * @brief Forwards upstream changes at a bounded rate
+ *
+ * The first change after a quiet period is forwarded immediately (leading
+ * edge). Further changes inside the interval are coalesced into a single
+ * trailing update carrying the latest upstream value, fired by the
+ * scheduler when the interval expires.
+ */
+template<class T>
+class ThrottleNode : public Qin<T> {
+public:
+    using SharedThrottle_T = std::shared_ptr<ThrottleNode<T>>;
+    using Source_T         = typename Yi<T, T>::SharedYi_T;
+
+private:
+    Source_T                   source;
+    Clock::duration            interval;
+    std::shared_ptr<Scheduler> scheduler;
+    Clock::time_point          lastEmit {};
+    bool                       emitted = false;
+    bool                       pending = false;
+    Scheduler::TimerId         timer   = 0;
+
+    void emit() {
+        lastEmit = scheduler->now();
+        emitted  = true;
+        this->set(source->get());
+    }
+
+protected:
+    void refresh() override {
+        if (pending) {
+            return; // trailing update will pick up the latest value
+        }
+
+        if (!emitted || scheduler->now() - lastEmit >= interval) {
+            emit();
+            return;
+        }
+
+        pending = true;
+        std::weak_ptr<QinBase> weak = this->self;
+        timer = scheduler->schedule(lastEmit + interval, [weak]() {
+            if (auto node = weak.lock()) {
+                auto* t    = static_cast<ThrottleNode<T>*>(node.get());
+                t->pending = false;
+                t->emit();
+            }
+        });
+    }
+
+public:
+    ThrottleNode(Source_T src, Clock::duration interval, std::shared_ptr<Scheduler> scheduler)
+        : source(std::move(src))
+        , interval(interval)
+        , scheduler(std::move(scheduler)) {
+        this->set_raw(source->get());
+    }
+
+    ~ThrottleNode() override {
+        if (pending) {
+            scheduler->cancel(timer);
+        }
+    }
+
+    bool hasPending() const { return pending; }
+
+    static SharedThrottle_T make(Source_T src, Clock::duration interval,
+                                 std::shared_ptr<Scheduler> scheduler) {
+        auto ptr  = std::make_shared<ThrottleNode<T>>(src, interval, std::move(scheduler));
+        ptr->self = ptr;
+        QinBase::connect(src, ptr);
+        ptr->retain(); // stateful: must see every upstream change
+        return ptr;
+    }
+};
+
+// ============================================================================
+// DebounceNode - Forward only after the upstream has been quiet
+// ============================================================================
+
+/**
+ * @brief Forwards the upstream value once no change arrived for `interval`
+ *
+ * Every upstream change restarts the timer, so a burst of writes produces a
+ * single downstream update carrying the last value of the burst.
+ */
+template<class T>
+class DebounceNode : public Qin<T> {
+public:
+    using SharedDebounce_T = std::shared_ptr<DebounceNode<T>>;
+    using Source_T         = typename Yi<T, T>::SharedYi_T;
+
+private:
+    Source_T                   source;
+    Clock::duration            interval;
+    std::shared_ptr<Scheduler> scheduler;
+    bool                       pending = false;
+    Scheduler::TimerId         timer   = 0;
+
+protected:
+    void refresh() override {
+        if (pending) {
+            scheduler->cancel(timer);
+        }
+
+        pending = true;
+        std::weak_ptr<QinBase> weak = this->self;
+        timer = scheduler->scheduleAfter(interval, [weak]() {
+            if (auto node = weak.lock()) {
+                auto* d    = static_cast<DebounceNode<T>*>(node.get());
+                d->pending = false;
+                d->set(d->source->get());
+            }
+        });
+    }
+
+public:
+    DebounceNode(Source_T src, Clock::duration interval, std::shared_ptr<Scheduler> scheduler)
+        : source(std::move(src))
+        , interval(interval)
+        , scheduler(std::move(scheduler)) {
+        this->set_raw(source->get());
+    }
+
+    ~DebounceNode() override {
+        if (pending) {
+            scheduler->cancel(timer);
+        }
+    }
+
+    bool hasPending() const { return pending; }
+
+    static SharedDebounce_T make(Source_T src, Clock::duration interval,
+                                 std::shared_ptr<Scheduler> scheduler) {
+        auto ptr  = std::make_shared<DebounceNode<T>>(src, interval, std::move(scheduler));
+        ptr->self = ptr;
+        QinBase::connect(src, ptr);
+        ptr->retain(); // stateful: must see every upstream change
+        return ptr;
+    }
+};
+
+// ============================================================================
+// SampleNode - Latch the upstream value whenever a trigger node changes
+// ============================================================================
+
+/**
+ * @brief Holds the source value captured at the trigger's last change
+ *
+ * Only the trigger is an upstream edge: writes to the source alone never
+ * propagate past this node.
+ */
+template<class T>
+class SampleNode : public Qin<T> {
+public:
+    using SharedSample_T = std::shared_ptr<SampleNode<T>>;
+    using Source_T       = typename Yi<T, T>::SharedYi_T;
+
+private:
+    Source_T source;
+
+protected:
+    void refresh() override {
+        this->set(source->get());
+    }
+
+public:
+    explicit SampleNode(Source_T src)
+        : source(std::move(src)) {
+        this->set_raw(source->get());
+    }
+
+    static SharedSample_T make(Source_T src, const std::shared_ptr<QinBase>& trigger) {
+        auto ptr  = std::make_shared<SampleNode<T>>(std::move(src));
+        ptr->self = ptr;
+        QinBase::connect(trigger, ptr);
+        ptr->retain(); // stateful: must see every upstream change
+        return ptr;
+    }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_NODES_TEMPORAL_H
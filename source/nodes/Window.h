@@ -0,0 +1,154 @@
+//
+// Window nodes - rolling statistics over a node's history
+//
+
+#ifndef ZONGHENG_NODES_WINDOW_H
+#define ZONGHENG_NODES_WINDOW_H
+
+#include "Qin.h"
+#include "../core/RingBuffer.h"
+
+namespace ZongHeng {
+
+// ============================================================================
+// WindowNode - Statistics over the last N values
+// ============================================================================
+
+/**
+ * @brief Rolling statistics over the last `n` values of a source node
+ *
+ * Each upstream change pushes one sample (evicting the oldest once full)
+ * and publishes the new WindowStats downstream.
+ */
+template<class T>
+class WindowNode : public Qin<WindowStats<T>> {
+public:
+    using SharedWindow_T = std::shared_ptr<WindowNode<T>>;
+    using Source_T       = typename Yi<T, T>::SharedYi_T;
+
+private:
+    Source_T         source;
+    size_t           limit;
+    RollingWindow<T> window;
+
+protected:
+    void refresh() override {
+        if (window.size() == limit) {
+            window.pop();
+        }
+        window.push(source->get());
+        this->set(window.stats());
+    }
+
+public:
+    WindowNode(Source_T src, size_t n)
+        : source(std::move(src))
+        , limit(n > 0 ? n : 1)
+        , window(limit) {
+        window.push(source->get());
+        this->set_raw(window.stats());
+    }
+
+    static SharedWindow_T make(Source_T src, size_t n) {
+        auto ptr  = std::make_shared<WindowNode<T>>(src, n);
+        ptr->self = ptr;
+        QinBase::connect(src, ptr);
+        ptr->retain(); // stateful: must see every upstream change
+        return ptr;
+    }
+};
+
+// ============================================================================
+// TimeWindowNode - Statistics over values younger than a time span
+// ============================================================================
+
+/**
+ * @brief Rolling statistics over the values seen during the last `span`
+ *
+ * Samples are stamped with the scheduler's clock. Expired samples are
+ * evicted on every update, and a timer at the oldest sample's expiry keeps
+ * the window draining while the source is quiet.
+ */
+template<class T>
+class TimeWindowNode : public Qin<WindowStats<T>> {
+public:
+    using SharedTimeWindow_T = std::shared_ptr<TimeWindowNode<T>>;
+    using Source_T           = typename Yi<T, T>::SharedYi_T;
+
+private:
+    Source_T                      source;
+    Clock::duration               span;
+    std::shared_ptr<Scheduler>    scheduler;
+    RollingWindow<T>              window;
+    RingBuffer<Clock::time_point> stamps;
+    bool                          pending = false;
+    Scheduler::TimerId            timer   = 0;
+
+    void evict(Clock::time_point now) {
+        while (!stamps.empty() && now - stamps.front() >= span) {
+            stamps.pop_front();
+            window.pop();
+        }
+    }
+
+    void arm() {
+        if (pending || stamps.empty()) {
+            return;
+        }
+
+        pending = true;
+        std::weak_ptr<QinBase> weak = this->self;
+        timer = scheduler->schedule(stamps.front() + span, [weak]() {
+            if (auto node = weak.lock()) {
+                auto* w    = static_cast<TimeWindowNode<T>*>(node.get());
+                w->pending = false;
+                w->evict(w->scheduler->now());
+                w->set(w->window.stats());
+                w->arm();
+            }
+        });
+    }
+
+protected:
+    void refresh() override {
+        auto now = scheduler->now();
+        evict(now);
+        window.push(source->get());
+        stamps.push_back(now);
+        this->set(window.stats());
+        arm();
+    }
+
+public:
+    TimeWindowNode(Source_T src, Clock::duration span, std::shared_ptr<Scheduler> scheduler,
+                   size_t capacityHint)
+        : source(std::move(src))
+        , span(span)
+        , scheduler(std::move(scheduler))
+        , window(capacityHint)
+        , stamps(capacityHint) {
+        window.push(source->get());
+        stamps.push_back(this->scheduler->now());
+        this->set_raw(window.stats());
+    }
+
+    ~TimeWindowNode() override {
+        if (pending) {
+            scheduler->cancel(timer);
+        }
+    }
+
+    static SharedTimeWindow_T make(Source_T src, Clock::duration span,
+                                   std::shared_ptr<Scheduler> scheduler, size_t capacityHint) {
+        auto ptr  = std::make_shared<TimeWindowNode<T>>(src, span, std::move(scheduler), capacityHint);
+        ptr->self = ptr;
+        QinBase::connect(src, ptr);
+        ptr->retain(); // stateful: must see every upstream change
+        ptr->arm();
+        return ptr;
+    }
+};
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_NODES_WINDOW_H
@@ -6,6 +6,9 @@
 #define ZONGHENG_NODES_YI_H
 
 #include "../core/ZongHengBase.h"
+#include "../core/InplaceFunction.h"
+#include "../core/Subscription.h"
+#include "../core/Ingest.h"
 
 // ============================================================================
 // Yi - Heterogeneous Node Template
@@ -20,95 +23,276 @@ protected:
     using NoneCVTInput  = typename std::remove_cv<INPUT_TYPE>::type;
     using NoneCVTOutput = typename std::remove_cv<OUTPUT_TYPE>::type;
 
-    NoneCVTInput                                      rawValue;
-    NoneCVTOutput                                     getterValue;
-    std::function<NoneCVTInput()>                     value;
-    std::function<NoneCVTOutput()>                    effect;
-    std::function<NoneCVTInput(const NoneCVTOutput&)> _setter;
-    std::function<NoneCVTOutput(const NoneCVTInput&)> _getter;
+    // Node callables live inline (see InplaceFunction): no allocation per node
+    template<class Sig>
+    using Callable = ZongHeng::InplaceFunction<Sig>;
+
+    NoneCVTInput                                   rawValue;
+    NoneCVTOutput                                  getterValue;
+    Callable<NoneCVTOutput()>                      effect;
+    Callable<NoneCVTInput(const NoneCVTOutput&)>   _setter;
+    Callable<NoneCVTOutput(const NoneCVTInput&)>   _getter;
+    Yi*                                            share       = nullptr; // Bound source whose rawValue this node reads
+    bool                                           outputStale = true;    // getterValue predates the stored value
+    std::atomic<ZongHeng::Ingest::Mailbox*>        mailbox { nullptr };   // Pending post() (created on first post)
+
+    /**
+     * @brief OUTPUT value of the stored value, through the getter or convert
+     *
+     * Cached in getterValue and rebuilt only after the stored value (or the
+     * getter) changes, so repeated reads of a hooked node run the getter
+     * once. Getters must therefore depend on their argument only.
+     */
+    const NoneCVTOutput& output() {
+        if (outputStale) {
+            if (_getter) {
+                getterValue = _getter(storage());
+            } else if constexpr (is_convertible_value_v<NoneCVTInput, NoneCVTOutput>) {
+                getterValue = convert<NoneCVTInput, NoneCVTOutput>(storage());
+            } else {
+                missingHook("getter");
+            }
+            outputStale = false;
+        }
+        return getterValue;
+    }
+
+    // INPUT value for a written OUTPUT value, through the setter or convert
+    template<class V>
+    NoneCVTInput input(V&& val) {
+        if (_setter) {
+            return _setter(val);
+        }
+        if constexpr (is_convertible_value_v<NoneCVTOutput, NoneCVTInput>) {
+            if constexpr (std::is_same_v<std::decay_t<V>, NoneCVTInput>) {
+                return std::forward<V>(val);
+            } else {
+                return convert<NoneCVTOutput, NoneCVTInput>(val);
+            }
+        } else {
+            missingHook("setter");
+        }
+    }
+
+    // Only Yi types without an implicit conversion need hooks to be read/written
+    [[noreturn]] static void missingHook(const char* which) {
+        throw std::runtime_error(std::string("Yi<") + typeid(INPUT_TYPE).name() + ", "
+                                 + typeid(OUTPUT_TYPE).name() + "> has no " + which + " and no conversion");
+    }
+
+    // The value this node holds: its own, or that of the source it follows
+    NoneCVTInput& storage() {
+        Yi* owner = this;
+        while (owner->share) {
+            owner = owner->share;
+        }
+        return owner->rawValue;
+    }
+
+    /**
+     * @brief Whether this bound node can read src's storage instead of a copy
+     *
+     * Both store convert(value) only when neither has a setter; a node
+     * with an effect or a constant keeps its own value, and following must
+     * not close a cycle.
+     */
+    bool canFollow(Yi& src) {
+        if (_setter || src._setter || effect || this->isConstant()) {
+            return false;
+        }
+        for (Yi* owner = &src; owner; owner = owner->share) {
+            if (owner == this) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Stop sharing: take a private copy of the current value
+    void unshare() {
+        if (share) {
+            rawValue = storage();
+            share    = nullptr;
+        }
+    }
+
+    friend class ZongHeng::Snapshot;
+    friend class ZongHeng::Checkpoint;
+    friend class ZongHeng::Journal;
+    friend class ZongHeng::FrozenGraph;
 
 public:
-    Yi() noexcept {
+    Yi() noexcept
+        : QinBase(ZongHeng::detail::typeTagOf<INPUT_TYPE, OUTPUT_TYPE>()) {
         set(NoneCVTInput {});
     }
 
     template FORWARD_CONSTRAINT(V, NoneCVTInput) explicit Yi(V&& v)
-        : rawValue(v) {
-        set_raw(std::forward<V>(v));
+        : QinBase(ZongHeng::detail::typeTagOf<INPUT_TYPE, OUTPUT_TYPE>())
+        , rawValue(std::forward<V>(v)) {
+        ++version;
+    }
+
+    ~Yi() override {
+        if (auto* box = mailbox.load(std::memory_order_acquire)) {
+            ZongHeng::Ingest::release(box);
+        }
+
+        // Bound nodes reading this node's storage keep its last value
+        for (auto& yi : Zong) {
+            if (yi->template isA<INPUT_TYPE, OUTPUT_TYPE>()) {
+                auto& bound = yi->template into_ref<INPUT_TYPE, OUTPUT_TYPE>();
+                if (bound.share == this) {
+                    bound.unshare();
+                }
+            }
+        }
     }
 
     template FORWARD_CONSTRAINT(V, NoneCVTInput) void set_raw(V&& val) {
-        rawValue = val;
-        value    = [=]() -> const NoneCVTInput& {
-            return rawValue;
-        };
+        assign(std::forward<V>(val));
+        this->invalidate();
     }
 
     template FORWARD_CONSTRAINT(V, NoneCVTInput) void set_inner(V&& val) {
-        rawValue = val;
+        share       = nullptr;
+        outputStale = true;
+        rawValue    = val;
+        ++version;
+        this->invalidate();
     }
 
     template FORWARD_CONSTRAINT(V, NoneCVTOutput) void set(V&& val) {
-        NoneCVTInput  tmp_out;
-        NoneCVTOutput tmp_val { static_cast<NoneCVTOutput>(val) };
+        if (this->isConstant()) {
+            throw std::runtime_error("Cannot write a constant node");
+        }
 
-        if (_setter) {
-            tmp_out = _setter(tmp_val);
-        } else {
-            tmp_out = convert<NoneCVTOutput, NoneCVTInput>(std::move(tmp_val));
+        ZongHeng::Batch batch; // subscribers are notified when the outermost pass ends
+
+        // Qin<T> without a setter: the written value is the stored value
+        if constexpr (std::is_same_v<NoneCVTInput, NoneCVTOutput>) {
+            if (!_setter) {
+                assign(std::forward<V>(val));
+                propagate(rawValue);
+                return;
+            }
+        }
+
+        NoneCVTOutput written(std::forward<V>(val));
+        assign(input(written));
+        propagate(written);
+    }
+
+    /**
+     * @brief Write from any thread; applied by the next Ingest::drain()
+     *
+     * The graph is not thread-safe, so producer threads post instead of
+     * calling set(). Only the latest value posted before a drain is
+     * applied. The node must stay alive while values are pending.
+     *
+     * @param val New OUTPUT value
+     * @example std::thread feed([price]() { price->post(readQuote()); });
+     */
+    template FORWARD_CONSTRAINT(V, NoneCVTOutput) void post(V&& val) {
+        auto* box = mailbox.load(std::memory_order_acquire);
+        if (!box) {
+            auto* made = new ZongHeng::Ingest::Mailbox(this, &applyPosted, &discardPosted);
+            if (mailbox.compare_exchange_strong(box, made, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                box = made;
+            } else {
+                delete made; // another producer created it first
+            }
+        }
+        ZongHeng::Ingest::global().post(*box, new NoneCVTOutput(std::forward<V>(val)));
+    }
+
+    /**
+     * @brief Tell hooks, subscribers, bound and derived nodes about a write
+     * @param val The value written, as passed to set()
+     */
+    void propagate(const NoneCVTOutput& val) {
+        if (writeHook) {
+            writeHook->onWrite(*this);
         }
 
-        set_raw(std::forward<NoneCVTInput>(tmp_out));
+        if (!Subscribers.empty()) {
+            ZongHeng::Batch::enqueue(*this);
+        }
 
-        // Update - only propagate to compatible types
+        // Update - only propagate to compatible types. Bound nodes that can
+        // share this node's storage follow it instead of receiving a copy.
         for (auto& yi : Zong) {
+            if (!yi->template isA<INPUT_TYPE, OUTPUT_TYPE>()) {
+                continue; // Skip incompatible type nodes
+            }
+            auto& bound = yi->template into_ref<INPUT_TYPE, OUTPUT_TYPE>();
+            if (bound.canFollow(*this)) {
+                bound.share       = this;
+                bound.outputStale = true;
+                bound.dirty       = false;
+                ++bound.version;
+                bound.propagate(val);
+                continue;
+            }
             try {
-                yi->template into<INPUT_TYPE, OUTPUT_TYPE>()->set(std::forward<NoneCVTOutput>(tmp_val));
+                bound.set(val);
             } catch (const std::runtime_error&) {
-                // Skip incompatible type nodes
+                // Skip nodes whose setter rejects the value
             }
         }
 
         for (auto& heng : Heng) {
+            if (!heng) {
+                continue; // unlinked edge (see dispose())
+            }
             try {
-                const auto& h = heng->template into<INPUT_TYPE, OUTPUT_TYPE>();
-                if (h->effect) {
-                    auto h_ef_val = h->effect();
-                    h->set(h_ef_val);
-                }
+                heng->refreshFrom(*this);
             } catch (const std::runtime_error&) {
-                // Skip incompatible type nodes
+                // Skip nodes that cannot accept the recomputed value
             }
         }
     }
 
     NoneCVTOutput get() {
-        NoneCVTInput v;
-
-        if (std::is_same_v<NoneCVTInput, NoneCVTOutput>) {
-            if (effect) {
-                if (_setter) {
-                    v = _setter(effect());
-                } else {
-                    v = convert<NoneCVTOutput, NoneCVTInput>(effect());
-                }
-            } else {
-                v = value();
-            }
-        } else {
-            if (effect) {
-                v = _setter(effect());
-            } else {
-                v = value();
+        ZongHeng::detail::DependencyScope::record(this);
+
+        // Clean hot nodes and clean cold nodes reuse the cached value.
+        // Nodes without tracked upstream edges cannot know when they go
+        // stale, so they recompute on every read.
+        if (effect && (dirty || Upstream.empty())) {
+            recompute();
+        }
+
+        if constexpr (std::is_same_v<NoneCVTInput, NoneCVTOutput>) {
+            if (!_getter) {
+                return storage();
             }
         }
 
-        if (_getter) {
-            getterValue = _getter(v);
-            return getterValue;
+        return output();
+    }
+
+    /**
+     * @brief Current value by reference, recomputing only if stale
+     *
+     * Unlike get(), returns the cached value without a copy. With a getter
+     * or conversion this is the cached OUTPUT value. The reference stays
+     * valid until the node is next written.
+     */
+    const NoneCVTOutput& peek() {
+        ZongHeng::detail::DependencyScope::record(this);
+
+        if (effect && (dirty || Upstream.empty())) {
+            recompute();
         }
 
-        return convert<INPUT_TYPE, OUTPUT_TYPE>(v);
+        if constexpr (std::is_same_v<NoneCVTInput, NoneCVTOutput>) {
+            if (!_getter) {
+                return storage();
+            }
+        }
+
+        return output();
     }
 
     template FORWARD_CONSTRAINT(V, NoneCVTOutput) Yi<INPUT_TYPE, OUTPUT_TYPE>& operator=(V&& val) {
@@ -120,9 +304,16 @@ public:
         return get();
     }
 
+    const std::type_info& nodeType() const override {
+        return typeid(Yi<INPUT_TYPE, OUTPUT_TYPE>);
+    }
+
     template<class Fn>
     void setEff(Fn eff) {
-        this->effect = eff;
+        unshare();
+        this->effect = ZongHeng::fitInline(std::move(eff));
+        this->dirty  = true;
+        this->invalidate();
     }
 
     template<class Fn>
@@ -138,24 +329,148 @@ public:
         auto new_qin = Yi<NoneCVTInput, NoneCVTOutput>::make(INPUT_TYPE {});
         new_qin->QinBase::lian(self, q);
         new_qin->setEff([this, q]() -> INPUT_TYPE {
-            return Fn()(this->get(), q->template into<INPUT_TYPE, OUTPUT_TYPE>()->get());
+            return Fn()(this->get(), q->template into_ref<INPUT_TYPE, OUTPUT_TYPE>().get());
         });
         return new_qin;
     }
 
-    void setter(decltype(_setter) s) {
-        _setter = s;
+    /**
+     * @brief Get notified after each propagation pass that changed this node
+     *
+     * The callback runs once per pass with the node's final value (never an
+     * intermediate one), and is skipped when the value compares equal to the
+     * last one delivered. Subscribing makes the node hot.
+     *
+     * @param cb Callback taking the node's OUTPUT value
+     * @param executor Optional executor the notification is posted to
+     * @return RAII handle; unsubscribes when destroyed
+     * @example auto sub = total->subscribe([](int v) { render(v); });
+     */
+    template<class Fn>
+    ZongHeng::Subscription subscribe(Fn cb, ZongHeng::Executor executor = nullptr) {
+        auto observation = this->observe();
+        auto last        = std::make_shared<NoneCVTOutput>(get());
+
+        auto id = this->addSubscriber([this, cb, executor, last]() {
+            auto v = get();
+            if constexpr (ZongHeng::is_equality_comparable<NoneCVTOutput>::value) {
+                if (v == *last) {
+                    return;
+                }
+            }
+            *last = v;
+
+            if (executor) {
+                executor([cb, v]() { cb(v); });
+            } else {
+                cb(v);
+            }
+        });
+
+        return ZongHeng::Subscription(this->self, id, std::move(observation));
+    }
+
+    template<class Fn>
+    void setter(Fn s) {
+        unshare();
+        _setter = ZongHeng::fitInline(std::move(s));
+        this->dirty = true;
+        this->invalidate();
     }
 
-    void getter(decltype(_getter) g) {
-        _getter = g;
+    template<class Fn>
+    void getter(Fn g) {
+        _getter     = ZongHeng::fitInline(std::move(g));
+        outputStale = true;
+        this->invalidate();
+    }
+
+    template<class G = std::nullptr_t, class S = std::nullptr_t>
+    void hook(G g = nullptr, S s = nullptr) {
+        getter(std::move(g));
+        setter(std::move(s));
     }
 
-    void hook(decltype(_getter) g = nullptr, decltype(_setter) s = nullptr) {
-        getter(g);
-        setter(s);
+protected:
+    template FORWARD_CONSTRAINT(V, NoneCVTInput) void assign(V&& val) {
+        share       = nullptr; // a write of its own ends following a bound source
+        outputStale = true;
+        rawValue    = std::forward<V>(val);
+        dirty       = false;
+        ++version;
     }
 
+    static void applyPosted(QinBase& node, void* value) {
+        std::unique_ptr<NoneCVTOutput> posted(static_cast<NoneCVTOutput*>(value));
+        static_cast<Yi&>(node).set(std::move(*posted));
+    }
+
+    static void discardPosted(void* value) {
+        delete static_cast<NoneCVTOutput*>(value);
+    }
+
+    // Evaluate the effect; its own upstream reads are not dependencies of a reader
+    NoneCVTOutput runEffect() {
+        ZongHeng::detail::DependencyScope untracked(nullptr);
+        return effect();
+    }
+
+    // Pull the effect into rawValue without forwarding (lazy read path)
+    void recompute() {
+        NoneCVTInput next = input(runEffect());
+
+        // An unchanged value keeps the cached OUTPUT (nodes without upstream
+        // edges recompute on every read)
+        if constexpr (ZongHeng::is_equality_comparable<NoneCVTInput>::value) {
+            if (!(next == rawValue)) {
+                outputStale = true;
+            }
+        } else {
+            outputStale = true;
+        }
+        rawValue = std::move(next);
+        dirty    = false;
+    }
+
+    void refresh() override {
+        if (!effect) {
+            return;
+        }
+
+        if (!this->isHot()) {
+            this->markDirty(); // cold: recompute on the next get()
+            return;
+        }
+
+        set(runEffect());
+    }
+
+    void activate() override {
+        if (effect && dirty) {
+            set(runEffect());
+        }
+    }
+
+    void retire() override {
+        if (effect && (dirty || Upstream.empty())) {
+            try {
+                recompute();
+            } catch (const std::runtime_error&) {
+                // Keep the previous value, like a rejected set()
+            }
+        }
+        effect = nullptr;
+        dirty  = false;
+    }
+
+    void unbound(QinBase& src) override {
+        if (share && static_cast<QinBase*>(share) == &src) {
+            unshare();
+        }
+    }
+
+public:
+
     // Factory method
     template<class... ARGS>
     static SharedYi_T make(ARGS&&... val) {
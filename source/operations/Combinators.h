@@ -6,6 +6,12 @@
 #define ZONGHENG_OPERATIONS_COMBINATORS_H
 
 #include "../nodes/Qin.h"
+#include "../nodes/Computed.h"
+#include "../nodes/Count.h"
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace ZongHeng {
@@ -101,6 +107,143 @@ std::shared_ptr<Qin<T>> fold(const std::vector<std::shared_ptr<Qin<T>>>& sources
     return result;
 }
 
+// ============================================================================
+// countIf / all / any - Incremental counts over many nodes
+// ============================================================================
+
+/**
+ * @brief Number of nodes whose value satisfies pred
+ *
+ * Maintained incrementally: a change to one input re-evaluates pred on
+ * that input only (see CountNode), instead of re-scanning every input
+ * the way a fold would.
+ *
+ * @param sources Input nodes
+ * @param pred Predicate (const T&) -> bool
+ * @return New Qin<size_t> node
+ * @example auto alerts = countIf(latencies, [](double ms) { return ms > 250.0; });
+ */
+template<class T, class Pred>
+std::shared_ptr<Qin<size_t>> countIf(std::vector<std::shared_ptr<Qin<T>>> sources, Pred pred) {
+    return CountNode<T, Pred, CountMode::Count>::make(std::move(sources), std::move(pred));
+}
+
+namespace detail {
+
+    struct IsTrue {
+        bool operator()(bool v) const { return v; }
+    };
+
+} // namespace detail
+
+/**
+ * @brief True when every node satisfies pred (true for no nodes)
+ *
+ * Keeps a count of matching inputs, so each change is O(1) and the result
+ * is only forwarded when it flips. Unlike operator& on Qin<bool>, inputs
+ * are never all re-read on a single change.
+ *
+ * @example auto ready = all(checks);  // checks: std::vector<std::shared_ptr<Qin<bool>>>
+ */
+template<class T, class Pred>
+std::shared_ptr<Qin<bool>> all(std::vector<std::shared_ptr<Qin<T>>> sources, Pred pred) {
+    return CountNode<T, Pred, CountMode::All>::make(std::move(sources), std::move(pred));
+}
+
+inline std::shared_ptr<Qin<bool>> all(std::vector<std::shared_ptr<Qin<bool>>> sources) {
+    return all(std::move(sources), detail::IsTrue {});
+}
+
+/**
+ * @brief True when at least one node satisfies pred (false for no nodes)
+ *
+ * @example auto alarm = any(alerts);
+ */
+template<class T, class Pred>
+std::shared_ptr<Qin<bool>> any(std::vector<std::shared_ptr<Qin<T>>> sources, Pred pred) {
+    return CountNode<T, Pred, CountMode::Any>::make(std::move(sources), std::move(pred));
+}
+
+inline std::shared_ptr<Qin<bool>> any(std::vector<std::shared_ptr<Qin<bool>>> sources) {
+    return any(std::move(sources), detail::IsTrue {});
+}
+
+// ============================================================================
+// combine - N-ary combination of heterogeneous nodes
+// ============================================================================
+
+namespace detail {
+
+    template<class R, class Fn, class... Ts>
+    std::shared_ptr<Qin<R>> combineNodes(Fn fn, std::shared_ptr<Qin<Ts>>... sources) {
+        auto result = Qin<R>::make(R {});
+
+        // One edge per distinct upstream node, so one refresh per change
+        auto link = [&result](const QinBase::SharedQinBase_T& up) {
+            auto& ups = result->Upstream;
+            if (std::find(ups.begin(), ups.end(), up.get()) == ups.end()) {
+                QinBase::connect(up, result);
+            }
+        };
+        (link(sources), ...);
+
+        result->setEff([fn, sources...]() -> R {
+            return fn(sources->peek()...);
+        });
+        return result;
+    }
+
+    template<class Tuple, size_t... I>
+    auto combineSplit(Tuple&& all, std::index_sequence<I...>) {
+        using Fn = std::decay_t<std::tuple_element_t<sizeof...(I), std::decay_t<Tuple>>>;
+        using R  = std::decay_t<std::invoke_result_t<Fn,
+            decltype(std::get<I>(all)->peek())...>>;
+
+        return combineNodes<R>(std::get<sizeof...(I)>(all), std::get<I>(all)...);
+    }
+
+} // namespace detail
+
+/**
+ * @brief Combine several nodes of different types into one derived node
+ *
+ * The last argument is the combining function; all others are source nodes.
+ * Each source is registered as an upstream edge exactly once, and the
+ * function receives the sources' cached values by const reference instead
+ * of re-running get() on each of them, so a change to any input costs a
+ * single recompute.
+ *
+ * @param args Source Qin nodes followed by fn(const T1&, const T2&, ...)
+ * @return New Qin node holding fn's result
+ *
+ * @example
+ * auto qty   = Qin<int>::make(3);
+ * auto price = Qin<double>::make(9.5);
+ * auto name  = Qin<std::string>::make("apple");
+ * auto line  = combine(qty, price, name, [](int q, double p, const std::string& n) {
+ *     return n + ": " + std::to_string(q * p);
+ * });
+ */
+template<class... Args>
+auto combine(Args... args) {
+    static_assert(sizeof...(Args) >= 2, "combine() needs at least one source and a function");
+    return detail::combineSplit(std::make_tuple(std::move(args)...),
+        std::make_index_sequence<sizeof...(Args) - 1> {});
+}
+
+/**
+ * @brief Zip several nodes into a node holding a tuple of their values
+ *
+ * @example
+ * auto pair = zip(qty, price);  // Qin<std::tuple<int, double>>
+ * auto [q, p] = pair->get();
+ */
+template<class... Ts>
+std::shared_ptr<Qin<std::tuple<Ts...>>> zip(std::shared_ptr<Qin<Ts>>... sources) {
+    return detail::combineNodes<std::tuple<Ts...>>(
+        [](const Ts&... values) { return std::tuple<Ts...>(values...); }, sources...);
+}
+
 // ============================================================================
 // when - Conditional branch selection
 // ============================================================================
@@ -128,6 +271,38 @@ std::shared_ptr<Qin<T>> when(std::shared_ptr<Qin<bool>> condition,
     return trueVal->when(condition, falseVal);
 }
 
+// ============================================================================
+// select - N-way branch selection
+// ============================================================================
+
+/**
+ * @brief Select one of several branches by an index node
+ *
+ * The N-way form of when(): only the index and the selected branch are
+ * subscribed, so the other branches stay cold and their writes cost
+ * nothing here. An index past the last branch selects the fallback.
+ *
+ * @param index Integral Qin node choosing the branch
+ * @param branches Candidate nodes
+ * @param fallback Node used when index is out of range
+ * @return New Qin node holding the selected branch's value
+ *
+ * @example
+ * auto mode   = Qin<int>::make(0);
+ * auto output = select(mode, { fast, accurate, cached }, idle);
+ */
+template<class I, class T>
+std::shared_ptr<Qin<T>> select(std::shared_ptr<Qin<I>>              index,
+                               std::vector<std::shared_ptr<Qin<T>>> branches,
+                               std::shared_ptr<Qin<T>>              fallback) {
+    static_assert(std::is_integral_v<I> || std::is_enum_v<I>, "select() needs an integral or enum index");
+
+    return computed([index, branches = std::move(branches), fallback]() -> T {
+        auto i = static_cast<size_t>(index->get());
+        return i < branches.size() ? branches[i]->get() : fallback->get();
+    });
+}
+
 } // namespace ZongHeng
 
 #endif // ZONGHENG_OPERATIONS_COMBINATORS_H
@@ -0,0 +1,602 @@
+//
+// FrozenGraph - A built graph compiled into a flat instruction tape
+//
+
+#ifndef ZONGHENG_OPERATIONS_FREEZE_H
+#define ZONGHENG_OPERATIONS_FREEZE_H
+
+#include "../nodes/Qin.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace ZongHeng {
+
+// ============================================================================
+// FrozenGraph - Topologically sorted tape over a contiguous value slab
+// ============================================================================
+
+/**
+ * @brief The graph reachable from some roots, compiled for fixed topology
+ *
+ * freeze() walks upstream from the roots and compiles every derived node
+ * it can into one instruction, in topological order:
+ *   - built-in operators (+, <, !, ...) become opcodes over the slab;
+ *   - other effect nodes (map, fold, user lambdas) become call slots that
+ *     run the node's own effect.
+ * The walk stops at inputs: source nodes, stateful nodes (throttle,
+ * window, countIf, ...), computed()/when() nodes and value types that are
+ * not registered. Writes to an input are copied into the slab by a write
+ * hook; at the end of the pass the interpreter sweeps only the dirty part
+ * of the tape, and an instruction whose value did not change does not
+ * dirty its consumers.
+ *
+ * Existing handles keep working. Each compiled node's value is written
+ * back to the node after it changes, so get(), subscribe() and nodes
+ * built on top later see frozen results. The Heng edges between frozen
+ * nodes are cut while the graph is frozen, and restored when the last
+ * FrozenGraph handle goes away.
+ *
+ * Only trivially copyable value types live in the slab; the common
+ * arithmetic types are registered by default (see registerType()).
+ *
+ * @example
+ * auto total  = price * qty + fee;
+ * auto frozen = ZongHeng::freeze({ total });
+ * *qty = 3;              // one tape sweep at the end of the pass
+ * total->get();          // frozen result
+ */
+class FrozenGraph : public std::enable_shared_from_this<FrozenGraph> {
+public:
+    using SharedNode_T = QinBase::SharedQinBase_T;
+
+    struct Stats {
+        size_t ops;         // Compiled nodes
+        size_t opcodes;     // ... executed as built-in opcodes
+        size_t calls;       // ... executed through their own effect
+        size_t inputs;      // Nodes feeding the tape
+        size_t slabBytes;   // Size of the value slab
+        size_t lastVisited; // Instructions executed by the last sweep
+    };
+
+private:
+    static constexpr uint32_t NoSlot = std::numeric_limits<uint32_t>::max();
+
+    struct Op;
+    using Exec = bool (*)(char* slab, const Op& op);
+
+    // Recompute one node into slab[out]; returns whether the value changed
+    struct Op {
+        Exec     exec;
+        uint32_t out;
+        uint32_t lhs;
+        uint32_t rhs;
+        NodeKind code; // Source for call slots
+        QinBase* node;
+        void (*store)(QinBase&, const char*);
+    };
+
+    struct TypeOps {
+        uint32_t tag;
+        size_t   size;
+        size_t   align;
+        bool (*hasEffect)(QinBase&);
+        bool (*plain)(QinBase&); // no getter/setter: rawValue is the value
+        void (*load)(QinBase&, char*);
+        void (*store)(QinBase&, const char*);
+        Exec (*opcode)(NodeKind); // for operands of this type
+        Exec call;
+    };
+
+    // Write hook of one input (see Journal::Tap)
+    class Tap : public WriteHook {
+    public:
+        FrozenGraph* graph;
+        uint32_t     index;
+
+        Tap(FrozenGraph* graph, uint32_t index)
+            : graph(graph)
+            , index(index) { }
+
+        void onWrite(QinBase& node) override {
+            graph->inputChanged(index, node);
+        }
+    };
+
+    struct Input {
+        SharedNode_T         node;
+        uint32_t             out = NoSlot;
+        void (*load)(QinBase&, char*) = nullptr;
+        std::unique_ptr<Tap> tap;
+        QinBase::Observation keepHot; // derived inputs must publish through set()
+    };
+
+    std::vector<Op>               ops; // Topological order
+    std::vector<Input>            inputs;
+    std::vector<SharedNode_T>     held; // Compiled nodes (upstream Heng no longer owns them)
+    std::vector<uint32_t>         consumerStart;
+    std::vector<uint32_t>         consumers; // Op indices, grouped by producer
+    std::vector<uint8_t>          dirty;
+    std::vector<std::max_align_t> slabStorage;
+    char*                         slab      = nullptr;
+    size_t                        slabBytes = 0;
+    size_t                        opcodes   = 0;
+    size_t                        visited   = 0;
+
+    uint32_t lo        = NoSlot; // First dirty op
+    uint32_t hi        = 0;      // Last dirty op
+    uint32_t cursor    = 0;      // Sweep position
+    bool     sweeping  = false;
+    bool     scheduled = false;
+
+    FrozenGraph() = default;
+
+    // ========================================================================
+    // Per-type operations
+    // ========================================================================
+
+    template<class T>
+    static Yi<T, T>& yi(QinBase& node) {
+        return static_cast<Yi<T, T>&>(node);
+    }
+
+    template<class T>
+    static bool hasEffect(QinBase& node) {
+        return static_cast<bool>(yi<T>(node).effect);
+    }
+
+    template<class T>
+    static bool plain(QinBase& node) {
+        auto& y = yi<T>(node);
+        return !y._getter && !y._setter;
+    }
+
+    template<class T>
+    static void load(QinBase& node, char* at) {
+        std::memcpy(at, &yi<T>(node).storage(), sizeof(T));
+    }
+
+    template<class T>
+    static void store(QinBase& n, const char* at) {
+        auto& node = yi<T>(n);
+        std::memcpy(&node.rawValue, at, sizeof(T));
+        node.outputStale = true;
+        node.dirty       = false;
+        ++node.version;
+        if (!node.Subscribers.empty()) {
+            Batch::enqueue(node);
+        }
+    }
+
+    template<class R>
+    static bool publish(char* at, const R& value) {
+        R old;
+        std::memcpy(&old, at, sizeof(R));
+        if (old == value) {
+            return false;
+        }
+        std::memcpy(at, &value, sizeof(R));
+        return true;
+    }
+
+    template<class T, class R, class F>
+    static bool binary(char* slab, const Op& op) {
+        T a, b;
+        std::memcpy(&a, slab + op.lhs, sizeof(T));
+        std::memcpy(&b, slab + op.rhs, sizeof(T));
+        return publish<R>(slab + op.out, static_cast<R>(F {}(a, b)));
+    }
+
+    template<class T, class R, class F>
+    static bool unary(char* slab, const Op& op) {
+        T a;
+        std::memcpy(&a, slab + op.lhs, sizeof(T));
+        return publish<R>(slab + op.out, static_cast<R>(F {}(a)));
+    }
+
+    template<class T>
+    static bool call(char* slab, const Op& op) {
+        auto& node = yi<T>(*op.node);
+        node.recompute();
+        return publish<T>(slab + op.out, node.rawValue);
+    }
+
+    template<class T>
+    static Exec opcode(NodeKind kind) {
+        constexpr bool arithmetic = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+        constexpr bool integral   = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+        switch (kind) {
+            case NodeKind::Add: if constexpr (arithmetic) { return &binary<T, T, std::plus<T>>; } break;
+            case NodeKind::Sub: if constexpr (arithmetic) { return &binary<T, T, std::minus<T>>; } break;
+            case NodeKind::Mul: if constexpr (arithmetic) { return &binary<T, T, std::multiplies<T>>; } break;
+            case NodeKind::Div: if constexpr (arithmetic) { return &binary<T, T, std::divides<T>>; } break;
+            case NodeKind::Mod: if constexpr (integral) { return &binary<T, T, std::modulus<T>>; } break;
+            case NodeKind::BitAnd: if constexpr (integral) { return &binary<T, T, std::bit_and<T>>; } break;
+            case NodeKind::BitOr: if constexpr (integral) { return &binary<T, T, std::bit_or<T>>; } break;
+            case NodeKind::BitXor: if constexpr (integral) { return &binary<T, T, std::bit_xor<T>>; } break;
+            case NodeKind::Eq: return &binary<T, bool, std::equal_to<T>>;
+            case NodeKind::Ne: return &binary<T, bool, std::not_equal_to<T>>;
+            case NodeKind::Lt: return &binary<T, bool, std::less<T>>;
+            case NodeKind::Gt: return &binary<T, bool, std::greater<T>>;
+            case NodeKind::Le: return &binary<T, bool, std::less_equal<T>>;
+            case NodeKind::Ge: return &binary<T, bool, std::greater_equal<T>>;
+            case NodeKind::Neg: if constexpr (arithmetic) { return &unary<T, T, std::negate<T>>; } break;
+            case NodeKind::BitNot: if constexpr (integral) { return &unary<T, T, std::bit_not<T>>; } break;
+            case NodeKind::Not: return &unary<T, bool, std::logical_not<T>>;
+            default: break;
+        }
+        return nullptr;
+    }
+
+    static std::vector<TypeOps>& registry() {
+        static std::vector<TypeOps> types = []() {
+            std::vector<TypeOps> built;
+            addType<bool>(built);
+            addType<char>(built);
+            addType<short>(built);
+            addType<int>(built);
+            addType<long>(built);
+            addType<long long>(built);
+            addType<unsigned short>(built);
+            addType<unsigned int>(built);
+            addType<unsigned long>(built);
+            addType<unsigned long long>(built);
+            addType<float>(built);
+            addType<double>(built);
+            return built;
+        }();
+        return types;
+    }
+
+    template<class T>
+    static void addType(std::vector<TypeOps>& types) {
+        static_assert(std::is_trivially_copyable_v<T>, "Frozen values are stored as raw bytes");
+
+        auto tag = detail::typeTagOf<T, T>();
+        for (auto& ops : types) {
+            if (ops.tag == tag) {
+                return;
+            }
+        }
+        types.push_back({ tag, sizeof(T), alignof(T), &hasEffect<T>, &plain<T>,
+                          &load<T>, &store<T>, &opcode<T>, &call<T> });
+    }
+
+    static const TypeOps* typeOf(const QinBase& node) {
+        for (auto& ops : registry()) {
+            if (ops.tag == node.typeTag) {
+                return &ops;
+            }
+        }
+        return nullptr;
+    }
+
+    static bool isOperator(NodeKind kind) {
+        return kind >= NodeKind::Add && kind <= NodeKind::Not;
+    }
+
+    static bool isBinary(NodeKind kind) {
+        return kind >= NodeKind::Add && kind <= NodeKind::Ge;
+    }
+
+    // Derived node the tape can recompute itself
+    static bool compilable(QinBase& node) {
+        auto* type = typeOf(node);
+        return type && !node.Upstream.empty() && !node.rewires && node.Zong.empty()
+            && type->hasEffect(node);
+    }
+
+    static std::vector<QinBase*> uniqueUpstream(const QinBase& node) {
+        std::vector<QinBase*> ups;
+        for (auto* up : node.Upstream) {
+            if (std::find(ups.begin(), ups.end(), up) == ups.end()) {
+                ups.push_back(up);
+            }
+        }
+        return ups;
+    }
+
+    // ========================================================================
+    // Compilation
+    // ========================================================================
+
+    void compile(const std::vector<SharedNode_T>& roots) {
+        // Post-order walk: inputs and compiled nodes, dependencies first
+        std::vector<QinBase*>                 order;
+        std::vector<QinBase*>                 inputNodes;
+        std::unordered_map<QinBase*, uint8_t> seen;
+
+        for (auto& root : roots) {
+            std::vector<std::pair<QinBase*, size_t>> stack { { root.get(), 0 } };
+            while (!stack.empty()) {
+                auto& [node, next] = stack.back();
+                if (next == 0 && !seen.emplace(node, 0).second) {
+                    stack.pop_back();
+                    continue;
+                }
+                if (compilable(*node) && next < node->Upstream.size()) {
+                    auto* up = node->Upstream[next++];
+                    if (!seen.count(up)) {
+                        stack.push_back({ up, 0 });
+                    }
+                    continue;
+                }
+                (compilable(*node) ? order : inputNodes).push_back(node);
+                stack.pop_back();
+            }
+        }
+
+        for (auto* node : inputNodes) {
+            if (node->writeHook) {
+                throw std::runtime_error("FrozenGraph: input node already has a write hook");
+            }
+        }
+
+        // Producer index: inputs first, then ops
+        std::unordered_map<QinBase*, uint32_t> producer;
+        for (auto* node : inputNodes) {
+            producer.emplace(node, static_cast<uint32_t>(producer.size()));
+        }
+        for (auto* node : order) {
+            producer.emplace(node, static_cast<uint32_t>(producer.size()));
+        }
+
+        // Slab layout
+        std::vector<uint32_t> slot(producer.size(), NoSlot);
+        auto place = [&](QinBase* node) {
+            if (auto* type = typeOf(*node)) {
+                slabBytes = (slabBytes + type->align - 1) & ~(type->align - 1);
+                slot[producer[node]] = static_cast<uint32_t>(slabBytes);
+                slabBytes += type->size;
+            }
+        };
+        for (auto* node : inputNodes) {
+            place(node);
+        }
+        for (auto* node : order) {
+            place(node);
+        }
+        slabStorage.resize((slabBytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t) + 1);
+        slab = reinterpret_cast<char*>(slabStorage.data());
+
+        // Inputs
+        for (auto* node : inputNodes) {
+            Input input;
+            input.node = node->self;
+            input.out  = slot[producer[node]];
+            if (auto* type = typeOf(*node)) {
+                input.load = type->load;
+            }
+            inputs.push_back(std::move(input));
+        }
+
+        // Instructions
+        for (auto* node : order) {
+            auto* type = typeOf(*node);
+            Op    op { type->call, slot[producer[node]], NoSlot, NoSlot, NodeKind::Source, node, type->store };
+
+            if (isOperator(node->kind) && type->plain(*node)) {
+                auto* lhs     = node->Upstream.front();
+                auto* rhs     = isBinary(node->kind) ? node->Upstream.back() : lhs;
+                auto* operand = typeOf(*lhs);
+                auto  exec    = operand ? operand->opcode(node->kind) : nullptr;
+
+                if (exec && operand->plain(*lhs) && operand->plain(*rhs)
+                    && slot[producer[lhs]] != NoSlot && slot[producer[rhs]] != NoSlot) {
+                    op.exec = exec;
+                    op.lhs  = slot[producer[lhs]];
+                    op.rhs  = slot[producer[rhs]];
+                    op.code = node->kind;
+                    ++opcodes;
+                }
+            }
+            ops.push_back(op);
+        }
+
+        // Consumers of each producer (CSR)
+        std::vector<std::vector<uint32_t>> byProducer(producer.size());
+        for (uint32_t i = 0; i < ops.size(); ++i) {
+            for (auto* up : uniqueUpstream(*ops[i].node)) {
+                byProducer[producer[up]].push_back(i);
+            }
+        }
+        consumerStart.push_back(0);
+        for (auto& list : byProducer) {
+            consumers.insert(consumers.end(), list.begin(), list.end());
+            consumerStart.push_back(static_cast<uint32_t>(consumers.size()));
+        }
+        dirty.assign(ops.size(), 0);
+
+        // Bring everything up to date and fill the slab
+        for (auto& input : inputs) {
+            if (!input.node->Upstream.empty()) {
+                input.keepHot = input.node->observe();
+            }
+            if (input.load) {
+                input.load(*input.node, slab + input.out);
+            }
+        }
+        for (auto& op : ops) {
+            auto& node = *op.node;
+            if (node.dirty) {
+                op.exec(slab, op); // upstream slab entries are current
+                op.store(node, slab + op.out);
+            } else {
+                typeOf(node)->load(node, slab + op.out);
+            }
+        }
+
+        // Frozen nodes are driven by the tape from now on
+        for (auto& op : ops) {
+            held.push_back(op.node->self);
+            ++op.node->frozen;
+            op.node->HengSlots.clear();
+            for (auto* up : uniqueUpstream(*op.node)) {
+                auto& hengs = up->Heng;
+                hengs.erase(std::remove_if(hengs.begin(), hengs.end(), [&op](const SharedNode_T& h) {
+                    return h.get() == op.node;
+                }), hengs.end());
+                up->reslotHeng();
+            }
+        }
+
+        for (uint32_t i = 0; i < inputs.size(); ++i) {
+            inputs[i].tap             = std::make_unique<Tap>(this, i);
+            inputs[i].node->writeHook = inputs[i].tap.get();
+        }
+    }
+
+    // ========================================================================
+    // Execution
+    // ========================================================================
+
+    void mark(uint32_t op) {
+        if (dirty[op]) {
+            return;
+        }
+        dirty[op] = 1;
+        if (op > hi) {
+            hi = op;
+        }
+        if (!(sweeping && op > cursor) && op < lo) {
+            lo = op;
+        }
+    }
+
+    void markConsumers(uint32_t producerIndex) {
+        for (auto c = consumerStart[producerIndex]; c < consumerStart[producerIndex + 1]; ++c) {
+            mark(consumers[c]);
+        }
+    }
+
+    void inputChanged(uint32_t index, QinBase& node) {
+        auto& input = inputs[index];
+        if (input.load) {
+            input.load(node, slab + input.out);
+        }
+        markConsumers(index);
+
+        if (!scheduled && !sweeping && lo != NoSlot) {
+            scheduled = true;
+            std::weak_ptr<FrozenGraph> weak = shared_from_this();
+            Batch::defer([weak]() {
+                if (auto graph = weak.lock()) {
+                    graph->run();
+                }
+            });
+        }
+    }
+
+    // Nodes outside the frozen graph that read a frozen node
+    static void forward(QinBase& node) {
+        for (auto& heng : node.Heng) {
+            if (!heng) {
+                continue;
+            }
+            try {
+                heng->refreshFrom(node);
+            } catch (const std::runtime_error&) {
+                // Skip nodes that cannot accept the recomputed value
+            }
+        }
+    }
+
+    void run() {
+        scheduled = false;
+        visited   = 0;
+
+        Batch batch; // subscribers of changed nodes are notified once, at the end
+        sweeping = true;
+        while (lo != NoSlot) {
+            cursor = lo;
+            lo     = NoSlot;
+            for (; cursor <= hi; ++cursor) {
+                if (!dirty[cursor]) {
+                    continue;
+                }
+                dirty[cursor] = 0;
+                ++visited;
+
+                auto& op      = ops[cursor];
+                bool  changed = false;
+                try {
+                    changed = op.exec(slab, op);
+                } catch (const std::runtime_error&) {
+                    // Keep the previous value, like a rejected set()
+                }
+                if (changed) {
+                    op.store(*op.node, slab + op.out);
+                    markConsumers(static_cast<uint32_t>(inputs.size()) + cursor);
+                    forward(*op.node);
+                }
+            }
+        }
+        sweeping = false;
+        hi       = 0;
+    }
+
+public:
+    FrozenGraph(const FrozenGraph&)            = delete;
+    FrozenGraph& operator=(const FrozenGraph&) = delete;
+
+    ~FrozenGraph() {
+        if (lo != NoSlot) {
+            run();
+        }
+        for (auto& input : inputs) {
+            input.node->writeHook = nullptr;
+        }
+        for (auto& node : held) {
+            --node->frozen;
+            for (auto* up : uniqueUpstream(*node)) {
+                if (!up->isConstant()) { // constant operands have no Heng edge
+                    up->Heng.push_back(node);
+                    node->HengSlots.push_back({ up, static_cast<uint32_t>(up->Heng.size() - 1) });
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Compile the graph reachable from roots
+     * @param roots Nodes whose values the tape must keep current
+     * @return Handle owning the tape; the graph thaws when it is destroyed
+     * @throws std::runtime_error if an input already has a write hook
+     */
+    static std::shared_ptr<FrozenGraph> freeze(const std::vector<SharedNode_T>& roots) {
+        std::shared_ptr<FrozenGraph> graph(new FrozenGraph());
+        graph->compile(roots);
+        return graph;
+    }
+
+    /**
+     * @brief Allow nodes of type Qin<T> to be compiled into the tape
+     */
+    template<class T>
+    static void registerType() {
+        addType<T>(registry());
+    }
+
+    Stats getStats() const {
+        return { ops.size(), opcodes, ops.size() - opcodes, inputs.size(), slabBytes, visited };
+    }
+};
+
+/**
+ * @brief Compile the graph reachable from roots (see FrozenGraph)
+ * @example auto frozen = ZongHeng::freeze({ total, alarm });
+ */
+inline std::shared_ptr<FrozenGraph> freeze(const std::vector<QinBase::SharedQinBase_T>& roots) {
+    return FrozenGraph::freeze(roots);
+}
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_OPERATIONS_FREEZE_H
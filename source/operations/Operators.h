@@ -6,6 +6,7 @@
 #define ZONGHENG_OPERATIONS_OPERATORS_H
 
 #include "../nodes/Qin.h"
+#include "../nodes/Map.h"
 
 // ============================================================================
 // Comparison Operators (return Qin<bool>)
@@ -14,101 +15,164 @@
 template<class T>
 std::shared_ptr<Qin<bool>> operator==(std::shared_ptr<Qin<T>> p,
                                        std::shared_ptr<Qin<T>> q) {
-    auto result = Qin<bool>::make(false);
-    result->QinBase::lian(p, q);
-    result->setEff([p, q]() -> bool {
-        return p->get() == q->get();
+    if (p->isConstant() && q->isConstant()) {
+        return Qin<bool>::constant(p->get() == q->get());
+    }
+    return ZongHeng::ExprTable::global().intern<bool>(ZongHeng::NodeKind::Eq, *p, *q, true, [&]() {
+        auto result = Qin<bool>::make(false);
+        result->QinBase::lian(p, q);
+        result->setEff([p, q]() -> bool {
+            return p->get() == q->get();
+        });
+        result->kind = ZongHeng::NodeKind::Eq;
+        return result;
     });
-    return result;
 }
 
 template<class T>
 std::shared_ptr<Qin<bool>> operator!=(std::shared_ptr<Qin<T>> p,
                                        std::shared_ptr<Qin<T>> q) {
-    auto result = Qin<bool>::make(false);
-    result->QinBase::lian(p, q);
-    result->setEff([p, q]() -> bool {
-        return p->get() != q->get();
+    if (p->isConstant() && q->isConstant()) {
+        return Qin<bool>::constant(p->get() != q->get());
+    }
+    return ZongHeng::ExprTable::global().intern<bool>(ZongHeng::NodeKind::Ne, *p, *q, true, [&]() {
+        auto result = Qin<bool>::make(false);
+        result->QinBase::lian(p, q);
+        result->setEff([p, q]() -> bool {
+            return p->get() != q->get();
+        });
+        result->kind = ZongHeng::NodeKind::Ne;
+        return result;
     });
-    return result;
 }
 
 template<class T>
 std::shared_ptr<Qin<bool>> operator<(std::shared_ptr<Qin<T>> p,
                                       std::shared_ptr<Qin<T>> q) {
-    auto result = Qin<bool>::make(false);
-    result->QinBase::lian(p, q);
-    result->setEff([p, q]() -> bool {
-        return p->get() < q->get();
+    if (p->isConstant() && q->isConstant()) {
+        return Qin<bool>::constant(p->get() < q->get());
+    }
+    return ZongHeng::ExprTable::global().intern<bool>(ZongHeng::NodeKind::Lt, *p, *q, false, [&]() {
+        auto result = Qin<bool>::make(false);
+        result->QinBase::lian(p, q);
+        result->setEff([p, q]() -> bool {
+            return p->get() < q->get();
+        });
+        result->kind = ZongHeng::NodeKind::Lt;
+        return result;
     });
-    return result;
 }
 
 template<class T>
 std::shared_ptr<Qin<bool>> operator>(std::shared_ptr<Qin<T>> p,
                                       std::shared_ptr<Qin<T>> q) {
-    auto result = Qin<bool>::make(false);
-    result->QinBase::lian(p, q);
-    result->setEff([p, q]() -> bool {
-        return p->get() > q->get();
+    if (p->isConstant() && q->isConstant()) {
+        return Qin<bool>::constant(p->get() > q->get());
+    }
+    return ZongHeng::ExprTable::global().intern<bool>(ZongHeng::NodeKind::Gt, *p, *q, false, [&]() {
+        auto result = Qin<bool>::make(false);
+        result->QinBase::lian(p, q);
+        result->setEff([p, q]() -> bool {
+            return p->get() > q->get();
+        });
+        result->kind = ZongHeng::NodeKind::Gt;
+        return result;
     });
-    return result;
 }
 
 template<class T>
 std::shared_ptr<Qin<bool>> operator<=(std::shared_ptr<Qin<T>> p,
                                        std::shared_ptr<Qin<T>> q) {
-    auto result = Qin<bool>::make(false);
-    result->QinBase::lian(p, q);
-    result->setEff([p, q]() -> bool {
-        return p->get() <= q->get();
+    if (p->isConstant() && q->isConstant()) {
+        return Qin<bool>::constant(p->get() <= q->get());
+    }
+    return ZongHeng::ExprTable::global().intern<bool>(ZongHeng::NodeKind::Le, *p, *q, false, [&]() {
+        auto result = Qin<bool>::make(false);
+        result->QinBase::lian(p, q);
+        result->setEff([p, q]() -> bool {
+            return p->get() <= q->get();
+        });
+        result->kind = ZongHeng::NodeKind::Le;
+        return result;
     });
-    return result;
 }
 
 template<class T>
 std::shared_ptr<Qin<bool>> operator>=(std::shared_ptr<Qin<T>> p,
                                        std::shared_ptr<Qin<T>> q) {
-    auto result = Qin<bool>::make(false);
-    result->QinBase::lian(p, q);
-    result->setEff([p, q]() -> bool {
-        return p->get() >= q->get();
+    if (p->isConstant() && q->isConstant()) {
+        return Qin<bool>::constant(p->get() >= q->get());
+    }
+    return ZongHeng::ExprTable::global().intern<bool>(ZongHeng::NodeKind::Ge, *p, *q, false, [&]() {
+        auto result = Qin<bool>::make(false);
+        result->QinBase::lian(p, q);
+        result->setEff([p, q]() -> bool {
+            return p->get() >= q->get();
+        });
+        result->kind = ZongHeng::NodeKind::Ge;
+        return result;
     });
-    return result;
 }
 
 // ============================================================================
-// Unary Operators
+// Unary Operators (fused into a map() chain they are applied to)
 // ============================================================================
 
 template<class T>
 std::shared_ptr<Qin<T>> operator-(std::shared_ptr<Qin<T>> p) {
-    auto result = Qin<T>::make(T{});
-    result->QinBase::lian(p, p);
-    result->setEff([p]() -> T {
-        return -p->get();
+    if (p->getKind() == ZongHeng::NodeKind::Map) { // extend the map() chain
+        return ZongHeng::MapNode<T>::chain(*p, [](const T& v) -> T { return -v; });
+    }
+    if (p->isConstant()) {
+        return Qin<T>::constant(-p->get());
+    }
+    return ZongHeng::ExprTable::global().intern<T>(ZongHeng::NodeKind::Neg, *p, *p, false, [&]() {
+        auto result = Qin<T>::make(T{});
+        result->QinBase::lian(p, p);
+        result->setEff([p]() -> T {
+            return -p->get();
+        });
+        result->kind = ZongHeng::NodeKind::Neg;
+        return result;
     });
-    return result;
 }
 
 template<class T>
 std::shared_ptr<Qin<T>> operator~(std::shared_ptr<Qin<T>> p) {
-    auto result = Qin<T>::make(T{});
-    result->QinBase::lian(p, p);
-    result->setEff([p]() -> T {
-        return ~p->get();
+    if (p->getKind() == ZongHeng::NodeKind::Map) { // extend the map() chain
+        return ZongHeng::MapNode<T>::chain(*p, [](const T& v) -> T { return ~v; });
+    }
+    if (p->isConstant()) {
+        return Qin<T>::constant(~p->get());
+    }
+    return ZongHeng::ExprTable::global().intern<T>(ZongHeng::NodeKind::BitNot, *p, *p, false, [&]() {
+        auto result = Qin<T>::make(T{});
+        result->QinBase::lian(p, p);
+        result->setEff([p]() -> T {
+            return ~p->get();
+        });
+        result->kind = ZongHeng::NodeKind::BitNot;
+        return result;
     });
-    return result;
 }
 
 template<class T>
 std::shared_ptr<Qin<bool>> operator!(std::shared_ptr<Qin<T>> p) {
-    auto result = Qin<bool>::make(false);
-    result->QinBase::lian(p, p);
-    result->setEff([p]() -> bool {
-        return !static_cast<bool>(p->get());
+    if (p->getKind() == ZongHeng::NodeKind::Map) { // extend the map() chain
+        return ZongHeng::MapNode<bool>::chain(*p, [](const T& v) -> bool { return !static_cast<bool>(v); });
+    }
+    if (p->isConstant()) {
+        return Qin<bool>::constant(!static_cast<bool>(p->get()));
+    }
+    return ZongHeng::ExprTable::global().intern<bool>(ZongHeng::NodeKind::Not, *p, *p, false, [&]() {
+        auto result = Qin<bool>::make(false);
+        result->QinBase::lian(p, p);
+        result->setEff([p]() -> bool {
+            return !static_cast<bool>(p->get());
+        });
+        result->kind = ZongHeng::NodeKind::Not;
+        return result;
     });
-    return result;
 }
 
 #endif // ZONGHENG_OPERATIONS_OPERATORS_H
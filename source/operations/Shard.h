@@ -0,0 +1,736 @@
+//
+// ShardedGraph - A built graph partitioned across threads
+//
+
+#ifndef ZONGHENG_OPERATIONS_SHARD_H
+#define ZONGHENG_OPERATIONS_SHARD_H
+
+#include "../nodes/Qin.h"
+#include "../core/SpscRing.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#define ZONGHENG_HAS_AFFINITY 1
+#endif
+
+namespace ZongHeng {
+
+// ============================================================================
+// ShardedGraph - Derived nodes split across pinned threads, run in epochs
+// ============================================================================
+
+/**
+ * @brief The graph connected to some roots, recomputed by several threads
+ *
+ * shard() collects every derived node connected to the roots (source nodes
+ * are the boundary) and assigns each to a shard: hinted nodes where the
+ * hint says, the rest by connected component, balanced by node count;
+ * a component too large for one shard is split along a topological order,
+ * then nodes move to the shard most of their neighbours are on when that
+ * cuts fewer edges. Each shard is owned by one thread (pinned to a CPU on
+ * Linux).
+ *
+ * Heng edges that leave a shard are cut. Writes between epochs are queued
+ * per shard; run() starts an epoch and returns when it is complete. An
+ * epoch is a sequence of rounds separated by barriers: a node's round is
+ * one more than that of any upstream node on another shard, so a node
+ * never reads a node that another thread may still write. A node whose
+ * value changed sends its index once per epoch to each shard consuming
+ * it, over a bounded single-producer/single-consumer ring sized so it
+ * cannot fill up.
+ *
+ * Between epochs the graph belongs to the calling thread again: read
+ * results and write sources there (or post() them and drain Ingest).
+ * Subscribers of sharded nodes are notified on their shard's thread.
+ * Nodes with a cut outgoing edge are kept hot so they publish through
+ * set(). computed() nodes and derived nodes with bindings cannot be
+ * sharded. The edges are restored when the ShardedGraph goes away.
+ *
+ * @example
+ * auto sharded = ZongHeng::shard({ totalA, totalB }, { 4 });
+ * *price = 10;        // queued for the next epoch
+ * sharded->run();     // four threads recompute; totalA/totalB are current
+ */
+class ShardedGraph {
+public:
+    using SharedNode_T = QinBase::SharedQinBase_T;
+
+    struct Options {
+        size_t                                          shards = 0;    // 0: one per hardware thread
+        bool                                            pin    = true; // Pin shard i to CPU i (Linux)
+        std::vector<std::pair<SharedNode_T, uint32_t>> hints;         // Nodes placed on a given shard
+    };
+
+    struct Stats {
+        size_t              shards;   // Threads
+        size_t              nodes;    // Sharded (derived) nodes
+        size_t              inputs;   // Nodes feeding them from the calling thread
+        size_t              cutEdges; // Heng edges carried between shards or rounds
+        size_t              rounds;   // Rounds (barriers + 1) per epoch
+        size_t              epochs;   // run() calls that had work
+        std::vector<size_t> shardNodes;
+    };
+
+private:
+    static constexpr uint32_t Caller = std::numeric_limits<uint32_t>::max(); // Owner of inputs
+
+    // Write hook of a node with cut outgoing edges
+    class Tap : public WriteHook {
+    public:
+        ShardedGraph* graph;
+        uint32_t      index;
+
+        Tap(ShardedGraph* graph, uint32_t index)
+            : graph(graph)
+            , index(index) { }
+
+        void onWrite(QinBase&) override {
+            graph->changed(index);
+        }
+    };
+
+    struct Target {
+        uint32_t              shard;
+        std::vector<QinBase*> nodes; // Consumers on that shard
+    };
+
+    // A node feeding other shards or later rounds
+    struct Producer {
+        SharedNode_T         node;
+        uint32_t             shard;        // Caller for inputs
+        uint64_t             sentEpoch = 0; // Epoch its change was last announced for
+        std::vector<Target>  targets;
+        std::unique_ptr<Tap> tap;
+        QinBase::Observation keepHot;
+    };
+
+    // Refresh of node after upstream changed
+    struct Work {
+        QinBase* node;
+        QinBase* upstream;
+    };
+
+    struct Shard {
+        std::thread                                      thread;
+        std::vector<std::vector<Work>>                   rounds; // Pending work by round
+        std::vector<std::unique_ptr<SpscRing<uint32_t>>> inbox;  // Rings from each shard
+        size_t                                           nodes = 0;
+    };
+
+    // Reusable barrier: spins briefly, then sleeps
+    class Barrier {
+        size_t                  parties;
+        std::atomic<size_t>     waiting { 0 };
+        std::atomic<uint64_t>   generation { 0 };
+        std::mutex              lock;
+        std::condition_variable wakeup;
+
+    public:
+        explicit Barrier(size_t parties)
+            : parties(parties) { }
+
+        void arriveAndWait() {
+            auto gen = generation.load(std::memory_order_acquire);
+            if (waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == parties) {
+                waiting.store(0, std::memory_order_relaxed);
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    generation.store(gen + 1, std::memory_order_release);
+                }
+                wakeup.notify_all();
+                return;
+            }
+            for (int spin = 0; spin < 4096; ++spin) {
+                if (generation.load(std::memory_order_acquire) != gen) {
+                    return;
+                }
+            }
+            std::unique_lock<std::mutex> guard(lock);
+            wakeup.wait(guard, [this, gen]() {
+                return generation.load(std::memory_order_acquire) != gen;
+            });
+        }
+    };
+
+    std::vector<Shard>                             shards;
+    std::vector<Producer>                          producers;
+    std::vector<std::pair<QinBase*, SharedNode_T>> cut;  // (upstream, consumer) edges removed from Heng
+    std::vector<SharedNode_T>                      held; // Sharded nodes
+    std::unordered_map<QinBase*, uint32_t>         shardOf;
+    std::unordered_map<QinBase*, uint32_t>         roundOf;
+    size_t                                         inputCount = 0;
+    uint32_t                                       rounds     = 1;
+
+    // Epoch control (epoch is only written by the calling thread, under lock)
+    std::mutex               lock;
+    std::condition_variable  start;
+    std::condition_variable  finished;
+    uint64_t                 epoch    = 0;
+    bool                     stopping = false;
+    bool                     pending  = false; // Work queued since the last epoch
+    std::atomic<bool>        running { false };
+    std::atomic<size_t>      remaining { 0 };
+    std::unique_ptr<Barrier> barrier;
+    size_t                   epochs = 0;
+
+    ShardedGraph() = default;
+
+    // ========================================================================
+    // Partitioning
+    // ========================================================================
+
+    static std::vector<QinBase*> uniqueUpstream(const QinBase& node) {
+        std::vector<QinBase*> ups;
+        for (auto* up : node.Upstream) {
+            if (std::find(ups.begin(), ups.end(), up) == ups.end()) {
+                ups.push_back(up);
+            }
+        }
+        return ups;
+    }
+
+    // Derived nodes connected to roots, in topological order; inputs on the side
+    static std::vector<QinBase*> collect(const std::vector<SharedNode_T>& roots, std::vector<QinBase*>& inputs) {
+        std::vector<QinBase*>                 derived;
+        std::unordered_map<QinBase*, uint8_t> seen;
+        std::vector<QinBase*>                 stack;
+        for (auto& root : roots) {
+            stack.push_back(root.get());
+        }
+        while (!stack.empty()) {
+            auto* node = stack.back();
+            stack.pop_back();
+            if (!seen.emplace(node, 0).second) {
+                continue;
+            }
+            if (node->Upstream.empty()) {
+                inputs.push_back(node); // boundary: its other consumers stay with the caller
+                continue;
+            }
+            if (node->rewires || !node->Zong.empty() || node->frozen) {
+                throw std::runtime_error("ShardedGraph: computed, bound, frozen or sharded nodes cannot be sharded");
+            }
+            derived.push_back(node);
+            for (auto* up : node->Upstream) {
+                stack.push_back(up);
+            }
+            for (auto& heng : node->Heng) {
+                if (heng) {
+                    stack.push_back(heng.get());
+                }
+            }
+        }
+
+        // Kahn's algorithm over the derived nodes
+        std::unordered_map<QinBase*, size_t> indegree;
+        for (auto* node : derived) {
+            indegree[node] = 0;
+        }
+        for (auto* node : derived) {
+            for (auto* up : uniqueUpstream(*node)) {
+                if (indegree.count(up)) {
+                    ++indegree[node];
+                }
+            }
+        }
+        std::vector<QinBase*> order;
+        for (auto* node : derived) {
+            if (indegree[node] == 0) {
+                order.push_back(node);
+            }
+        }
+        for (size_t i = 0; i < order.size(); ++i) {
+            for (auto& heng : order[i]->Heng) {
+                if (heng && indegree.count(heng.get()) && --indegree[heng.get()] == 0) {
+                    order.push_back(heng.get());
+                }
+            }
+        }
+        if (order.size() != derived.size()) {
+            throw std::runtime_error("ShardedGraph: the graph has a cycle");
+        }
+        return order;
+    }
+
+    void partition(const std::vector<QinBase*>& order, const Options& options) {
+        const size_t n     = order.size();
+        const size_t count = shards.size();
+        const size_t cap   = (n + count - 1) / count;
+        const size_t limit = cap + cap / 4; // Whole components may overshoot a little
+
+        std::unordered_map<QinBase*, uint32_t> index;
+        for (uint32_t i = 0; i < n; ++i) {
+            index.emplace(order[i], i);
+        }
+
+        // Undirected adjacency between derived nodes
+        std::vector<std::vector<uint32_t>> adjacent(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            for (auto* up : uniqueUpstream(*order[i])) {
+                auto found = index.find(up);
+                if (found != index.end()) {
+                    adjacent[i].push_back(found->second);
+                    adjacent[found->second].push_back(i);
+                }
+            }
+        }
+
+        // Connected components, each listed in topological order
+        std::vector<uint32_t> parent(n);
+        std::iota(parent.begin(), parent.end(), 0);
+        auto root = [&parent](uint32_t i) {
+            while (parent[i] != i) {
+                i = parent[i] = parent[parent[i]];
+            }
+            return i;
+        };
+        for (uint32_t i = 0; i < n; ++i) {
+            for (auto j : adjacent[i]) {
+                parent[root(i)] = root(j);
+            }
+        }
+        std::unordered_map<uint32_t, std::vector<uint32_t>> byRoot;
+        for (uint32_t i = 0; i < n; ++i) {
+            byRoot[root(i)].push_back(i);
+        }
+        std::vector<std::vector<uint32_t>> components;
+        for (auto& entry : byRoot) {
+            components.push_back(std::move(entry.second));
+        }
+        std::sort(components.begin(), components.end(), [](const auto& a, const auto& b) {
+            return a.size() != b.size() ? a.size() > b.size() : a.front() < b.front();
+        });
+
+        constexpr uint32_t None = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> assigned(n, None);
+        std::vector<uint8_t>  hinted(n, 0);
+        std::vector<size_t>   load(count, 0);
+
+        for (auto& [node, shard] : options.hints) {
+            auto found = index.find(node.get());
+            if (found == index.end()) {
+                continue; // not a derived node of this graph
+            }
+            if (shard >= count) {
+                throw std::runtime_error("ShardedGraph: hint names shard " + std::to_string(shard)
+                                         + " of " + std::to_string(count));
+            }
+            assigned[found->second] = shard;
+            hinted[found->second]   = 1;
+            ++load[shard];
+        }
+
+        auto leastLoaded = [&load]() {
+            return static_cast<uint32_t>(std::min_element(load.begin(), load.end()) - load.begin());
+        };
+
+        for (auto& component : components) {
+            uint32_t preferred = None;
+            size_t   open      = 0;
+            for (auto i : component) {
+                if (hinted[i] && preferred == None) {
+                    preferred = assigned[i];
+                }
+                open += assigned[i] == None;
+            }
+
+            uint32_t whole = preferred;
+            if (whole == None && load[leastLoaded()] + open <= limit) {
+                whole = leastLoaded();
+            }
+            uint32_t current = whole == None ? leastLoaded() : whole;
+            for (auto i : component) {
+                if (assigned[i] != None) {
+                    continue;
+                }
+                if (whole == None && load[current] >= cap) {
+                    current = leastLoaded();
+                }
+                assigned[i] = current;
+                ++load[current];
+            }
+        }
+
+        // Move nodes to the shard most of their neighbours are on
+        for (int pass = 0; pass < 2; ++pass) {
+            for (uint32_t i = 0; i < n; ++i) {
+                if (hinted[i]) {
+                    continue;
+                }
+                std::unordered_map<uint32_t, size_t> votes;
+                for (auto j : adjacent[i]) {
+                    ++votes[assigned[j]];
+                }
+                uint32_t best  = assigned[i];
+                size_t   score = votes[best];
+                for (auto& [shard, neighbours] : votes) {
+                    if (neighbours > score && load[shard] < limit) {
+                        best  = shard;
+                        score = neighbours;
+                    }
+                }
+                if (best != assigned[i]) {
+                    --load[assigned[i]];
+                    ++load[best];
+                    assigned[i] = best;
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < n; ++i) {
+            shardOf.emplace(order[i], assigned[i]);
+            ++shards[assigned[i]].nodes;
+        }
+    }
+
+    // ========================================================================
+    // Wiring
+    // ========================================================================
+
+    uint32_t ownerOf(QinBase* node) const {
+        auto found = shardOf.find(node);
+        return found != shardOf.end() ? found->second : Caller;
+    }
+
+    uint32_t roundOfNode(QinBase* node) const {
+        auto found = roundOf.find(node);
+        return found != roundOf.end() ? found->second : 0;
+    }
+
+    void wire(const std::vector<QinBase*>& order, const std::vector<QinBase*>& inputs) {
+        // Rounds: one more than any upstream node owned by another thread
+        for (auto* node : order) {
+            uint32_t round = 1;
+            for (auto* up : uniqueUpstream(*node)) {
+                uint32_t step = ownerOf(up) != ownerOf(node) ? 1 : 0;
+                round         = std::max(round, roundOfNode(up) + step);
+            }
+            roundOf.emplace(node, round);
+            rounds = std::max(rounds, round);
+        }
+        for (auto& shard : shards) {
+            shard.rounds.resize(rounds + 1);
+            shard.inbox.resize(shards.size());
+        }
+
+        // Edges into another shard or a later round are cut and announced
+        std::vector<std::vector<size_t>> ringSize(shards.size(), std::vector<size_t>(shards.size(), 0));
+        auto scan = [&](QinBase* node) {
+            Producer                                       producer;
+            std::vector<std::pair<QinBase*, SharedNode_T>> edges;
+            producer.shard = ownerOf(node);
+            for (auto& heng : node->Heng) {
+                auto* consumer = heng.get();
+                if (!consumer || !shardOf.count(consumer)) {
+                    continue;
+                }
+                if (producer.shard == ownerOf(consumer) && roundOfNode(node) == roundOfNode(consumer)) {
+                    continue; // same thread, same round: ordinary propagation
+                }
+                auto target = std::find_if(producer.targets.begin(), producer.targets.end(), [&](const Target& t) {
+                    return t.shard == ownerOf(consumer);
+                });
+                if (target == producer.targets.end()) {
+                    producer.targets.push_back({ ownerOf(consumer), {} });
+                    target = producer.targets.end() - 1;
+                }
+                target->nodes.push_back(consumer);
+                edges.emplace_back(node, heng);
+            }
+            if (producer.targets.empty()) {
+                return;
+            }
+            if (node->writeHook) {
+                throw std::runtime_error("ShardedGraph: node already has a write hook");
+            }
+            cut.insert(cut.end(), edges.begin(), edges.end());
+            if (producer.shard != Caller) {
+                for (auto& target : producer.targets) {
+                    if (target.shard != producer.shard) {
+                        ++ringSize[producer.shard][target.shard];
+                    }
+                }
+            }
+            producer.node = node->self;
+            producers.push_back(std::move(producer));
+        };
+        for (auto* node : inputs) {
+            scan(node);
+        }
+        for (auto* node : order) {
+            scan(node);
+        }
+
+        for (size_t from = 0; from < shards.size(); ++from) {
+            for (size_t to = 0; to < shards.size(); ++to) {
+                if (ringSize[from][to]) {
+                    shards[to].inbox[from] = std::make_unique<SpscRing<uint32_t>>(ringSize[from][to]);
+                }
+            }
+        }
+
+        for (auto& producer : producers) {
+            if (producer.shard != Caller) {
+                producer.keepHot = producer.node->observe(); // publish through set(), not markDirty()
+            }
+        }
+        for (auto& [up, consumer] : cut) {
+            auto& hengs = up->Heng;
+            hengs.erase(std::remove(hengs.begin(), hengs.end(), consumer), hengs.end());
+            up->reslotHeng();
+            auto& slots = consumer->HengSlots;
+            slots.erase(std::remove_if(slots.begin(), slots.end(), [up = up](const QinBase::Slot& slot) {
+                return slot.node == up;
+            }), slots.end());
+        }
+
+        for (uint32_t i = 0; i < producers.size(); ++i) {
+            producers[i].tap             = std::make_unique<Tap>(this, i);
+            producers[i].node->writeHook = producers[i].tap.get();
+        }
+        for (auto* node : order) {
+            held.push_back(node->self);
+            ++node->frozen;
+        }
+        inputCount = inputs.size();
+    }
+
+    // ========================================================================
+    // Execution
+    // ========================================================================
+
+    // A producer's value changed: queue its consumers (once per epoch)
+    void changed(uint32_t index) {
+        auto& producer = producers[index];
+        bool  inEpoch  = running.load(std::memory_order_relaxed);
+        auto  tag      = inEpoch ? epoch : epoch + 1;
+        if (producer.sentEpoch == tag) {
+            return;
+        }
+        producer.sentEpoch = tag;
+
+        for (auto& target : producer.targets) {
+            if (!inEpoch || target.shard == producer.shard) {
+                // Shards are idle, or the target is this thread's own shard
+                for (auto* node : target.nodes) {
+                    shards[target.shard].rounds[roundOfNode(node)].push_back({ node, producer.node.get() });
+                }
+                if (!inEpoch) {
+                    pending = true;
+                }
+            } else {
+                shards[target.shard].inbox[producer.shard]->push(index); // sized to never fill
+            }
+        }
+    }
+
+    void receive(uint32_t self) {
+        auto& shard = shards[self];
+        for (auto& ring : shard.inbox) {
+            uint32_t index;
+            while (ring && ring->pop(index)) {
+                auto& producer = producers[index];
+                for (auto& target : producer.targets) {
+                    if (target.shard != self) {
+                        continue;
+                    }
+                    for (auto* node : target.nodes) {
+                        shard.rounds[roundOfNode(node)].push_back({ node, producer.node.get() });
+                    }
+                }
+            }
+        }
+    }
+
+    void process(uint32_t self, uint32_t round) {
+        auto& work = shards[self].rounds[round];
+        if (work.empty()) {
+            return;
+        }
+        Batch batch; // this shard's subscribers are notified once per round
+        for (auto& item : work) {
+            try {
+                item.node->refreshFrom(*item.upstream);
+            } catch (const std::runtime_error&) {
+                // Skip nodes that cannot accept the recomputed value
+            }
+        }
+        work.clear();
+    }
+
+    void work(uint32_t self) {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                start.wait(guard, [this, seen]() { return stopping || epoch != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = epoch;
+            }
+
+            for (uint32_t round = 1; round <= rounds; ++round) {
+                if (round > 1) {
+                    barrier->arriveAndWait(); // earlier rounds are final
+                }
+                receive(self);
+                process(self, round);
+            }
+
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> guard(lock);
+                finished.notify_one();
+            }
+        }
+    }
+
+    static void pin(std::thread& thread, size_t cpu) {
+#ifdef ZONGHENG_HAS_AFFINITY
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu % CPU_SETSIZE, &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+        (void)thread;
+        (void)cpu;
+#endif
+    }
+
+    void launch(const Options& options) {
+        barrier      = std::make_unique<Barrier>(shards.size());
+        size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+        for (uint32_t i = 0; i < shards.size(); ++i) {
+            shards[i].thread = std::thread([this, i]() { work(i); });
+            if (options.pin) {
+                pin(shards[i].thread, i % cores);
+            }
+        }
+    }
+
+public:
+    ShardedGraph(const ShardedGraph&)            = delete;
+    ShardedGraph& operator=(const ShardedGraph&) = delete;
+
+    ~ShardedGraph() {
+        if (pending) {
+            run();
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        start.notify_all();
+        for (auto& shard : shards) {
+            if (shard.thread.joinable()) {
+                shard.thread.join();
+            }
+        }
+
+        for (auto& producer : producers) {
+            producer.node->writeHook = nullptr;
+        }
+        for (auto& [up, consumer] : cut) {
+            up->Heng.push_back(consumer);
+            consumer->HengSlots.push_back({ up, static_cast<uint32_t>(up->Heng.size() - 1) });
+        }
+        for (auto& node : held) {
+            --node->frozen;
+        }
+    }
+
+    /**
+     * @brief Partition the graph connected to roots and start its threads
+     * @param roots Nodes whose values must be kept current
+     * @param options Shard count, CPU pinning and placement hints
+     * @return Handle owning the threads; the graph is restored when it is destroyed
+     * @throws std::runtime_error for computed/bound/frozen nodes, cycles or bad hints
+     */
+    static std::unique_ptr<ShardedGraph> shard(const std::vector<SharedNode_T>& roots, const Options& options) {
+        std::unique_ptr<ShardedGraph> graph(new ShardedGraph());
+        size_t count = options.shards ? options.shards : std::max(1u, std::thread::hardware_concurrency());
+        graph->shards.resize(count);
+
+        std::vector<QinBase*> inputs;
+        auto                  order = collect(roots, inputs);
+        graph->partition(order, options);
+        graph->wire(order, inputs);
+        graph->launch(options);
+        return graph;
+    }
+
+    static std::unique_ptr<ShardedGraph> shard(const std::vector<SharedNode_T>& roots) {
+        return shard(roots, Options());
+    }
+
+    /**
+     * @brief Run one epoch: propagate every write made since the last one
+     *
+     * Blocks until all shards passed the last round. Call from the thread
+     * that writes the sources.
+     */
+    void run() {
+        if (!pending) {
+            return;
+        }
+        pending = false;
+        ++epochs;
+
+        remaining.store(shards.size(), std::memory_order_relaxed);
+        running.store(true, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            ++epoch;
+        }
+        start.notify_all();
+
+        std::unique_lock<std::mutex> guard(lock);
+        finished.wait(guard, [this]() { return remaining.load(std::memory_order_acquire) == 0; });
+        running.store(false, std::memory_order_relaxed);
+    }
+
+    // Shard a node was assigned to (Options::shards if it is not sharded)
+    size_t shardOfNode(const SharedNode_T& node) const {
+        auto owner = ownerOf(node.get());
+        return owner == Caller ? shards.size() : owner;
+    }
+
+    Stats getStats() const {
+        Stats stats { shards.size(), held.size(), inputCount, cut.size(), rounds, epochs, {} };
+        for (auto& shard : shards) {
+            stats.shardNodes.push_back(shard.nodes);
+        }
+        return stats;
+    }
+};
+
+/**
+ * @brief Partition the graph connected to roots across threads (see ShardedGraph)
+ * @example auto sharded = ZongHeng::shard({ total }, { 8 });
+ */
+inline std::unique_ptr<ShardedGraph> shard(const std::vector<QinBase::SharedQinBase_T>& roots,
+                                           const ShardedGraph::Options& options) {
+    return ShardedGraph::shard(roots, options);
+}
+
+inline std::unique_ptr<ShardedGraph> shard(const std::vector<QinBase::SharedQinBase_T>& roots) {
+    return ShardedGraph::shard(roots);
+}
+
+} // namespace ZongHeng
+
+#endif // ZONGHENG_OPERATIONS_SHARD_H
@@ -0,0 +1,167 @@
+//
+// Test lazy (hot/cold) activation of derived nodes
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <string>
+
+using namespace ZongHeng;
+
+// ============================================================================
+// Cold Nodes
+// ============================================================================
+
+int test_cold_node_not_recomputed_on_write() {
+    auto source = Qin<int>::make(1);
+    int  calls  = 0;
+    auto derived = source->map([&calls](int x) {
+        ++calls;
+        return x * 10;
+    });
+
+    ASSERT_I(derived->isHot(), false);
+
+    for (int i = 0; i < 100; ++i) {
+        *source = i;
+    }
+    ASSERT_I(calls, 0);           // writes only mark it dirty
+    ASSERT_I(derived->isDirty(), true);
+
+    ASSERT_I(derived->get(), 990); // first read recomputes once
+    ASSERT_I(calls, 1);
+
+    ASSERT_I(derived->get(), 990); // clean read hits the cache
+    ASSERT_I(calls, 1);
+
+    return 0;
+}
+
+int test_cold_chain_costs_nothing_per_write() {
+    auto source = Qin<int>::make(0);
+    int  calls  = 0;
+
+    auto node = source->map([&calls](int x) { ++calls; return x + 1; });
+    for (int i = 0; i < 50; ++i) {
+        node = node->map([&calls](int x) { ++calls; return x + 1; });
+    }
+
+    *source = 1; // marks the chain dirty once
+    *source = 2; // stops at the first dirty node
+    ASSERT_I(calls, 0);
+    ASSERT_I(node->get(), 53);
+    ASSERT_I(calls, 51);
+
+    return 0;
+}
+
+// ============================================================================
+// Hot Nodes
+// ============================================================================
+
+int test_observe_makes_upstream_hot() {
+    auto a = Qin<int>::make(1);
+    auto b = Qin<int>::make(2);
+    auto sum     = a + b;
+    auto doubled = sum * Qin<int>::make(2);
+
+    {
+        auto watch = doubled->observe();
+        ASSERT_I(doubled->isHot(), true);
+        ASSERT_I(sum->isHot(), true);
+        ASSERT_I(static_cast<int>(sum->getObserverCount()), 1);
+    }
+
+    ASSERT_I(doubled->isHot(), false);
+    ASSERT_I(sum->isHot(), false);
+
+    return 0;
+}
+
+int test_hot_node_recomputes_eagerly() {
+    auto source = Qin<int>::make(1);
+    int  calls  = 0;
+    auto derived = source->map([&calls](int x) {
+        ++calls;
+        return x + 1;
+    });
+
+    auto watch = derived->observe();
+    ASSERT_I(calls, 1); // activation brings the node up to date once
+
+    *source = 5;
+    *source = 6;
+    ASSERT_I(calls, 3);
+
+    ASSERT_I(derived->get(), 7); // served from the cache
+    ASSERT_I(calls, 3);
+
+    return 0;
+}
+
+int test_activation_recomputes_once() {
+    auto a = Qin<int>::make(1);
+    int  calls = 0;
+
+    auto left  = a->map([](int x) { return x + 1; });
+    auto right = a->map([](int x) { return x * 2; });
+    auto both  = left->lian(right, [left, right, &calls]() -> int {
+        ++calls;
+        return left->get() + right->get();
+    });
+
+    *a = 10; // everything cold and dirty
+    ASSERT_I(calls, 0);
+
+    auto watch = both->observe();
+    ASSERT_I(calls, 1);
+    ASSERT_I(both->get(), 31);
+    ASSERT_I(calls, 1);
+
+    return 0;
+}
+
+int test_bind_keeps_derived_source_hot() {
+    auto first = Qin<std::string>::make("Hello ");
+    auto last  = Qin<std::string>::make("World");
+    auto view  = Qin<std::string>::make();
+
+    view << (first + last);
+
+    *last = std::string("There");
+    ASSERT_S(view->get(), std::string("Hello There"));
+
+    return 0;
+}
+
+int test_set_inner_invalidates() {
+    auto a = Qin<int>::make(3);
+    auto squared = a->map([](int x) { return x * x; });
+
+    ASSERT_I(squared->get(), 9);
+
+    a->set_inner(4); // no propagation, but derived nodes go stale
+    ASSERT_I(squared->isDirty(), true);
+    ASSERT_I(squared->get(), 16);
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // cold
+        test_cold_node_not_recomputed_on_write(),
+        test_cold_chain_costs_nothing_per_write(),
+        // hot
+        test_observe_makes_upstream_hot(),
+        test_hot_node_recomputes_eagerly(),
+        test_activation_recomputes_once(),
+        test_bind_keeps_derived_source_hot(),
+        test_set_inner_invalidates()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
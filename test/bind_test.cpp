@@ -0,0 +1,160 @@
+//
+// Test bound nodes sharing their source's storage
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace ZongHeng;
+
+// Payload counting its copies
+struct Blob {
+    static int copies;
+
+    std::vector<int> data;
+
+    Blob() = default;
+    explicit Blob(std::vector<int> d)
+        : data(std::move(d)) { }
+    Blob(const Blob& other)
+        : data(other.data) { ++copies; }
+    Blob(Blob&&) = default;
+    Blob& operator=(const Blob& other) {
+        data = other.data;
+        ++copies;
+        return *this;
+    }
+    Blob& operator=(Blob&&) = default;
+
+    bool operator==(const Blob& other) const { return data == other.data; }
+};
+
+int Blob::copies = 0;
+
+// ============================================================================
+// Shared Storage
+// ============================================================================
+
+int test_bind_views_share_storage() {
+    auto alone = Qin<Blob>::make();
+    Blob::copies = 0;
+    *alone = Blob({ 1, 2, 3 });
+    int single = Blob::copies;
+
+    auto source = Qin<Blob>::make();
+    std::vector<std::shared_ptr<Qin<Blob>>> views;
+    for (int i = 0; i < 4; ++i) {
+        views.push_back(Qin<Blob>::make());
+        views.back() << source;
+    }
+
+    Blob::copies = 0;
+    *source = Blob({ 4, 5, 6 });
+    ASSERT_I(Blob::copies, single); // views add no copies
+
+    for (auto& view : views) {
+        ASSERT_I(static_cast<int>(view->peek().data.size()), 3);
+        ASSERT_I(view->peek().data[2], 6);
+    }
+    ASSERT_I(&views[0]->peek() == &source->peek(), true);
+
+    return 0;
+}
+
+int test_bind_write_to_view_is_local() {
+    auto source = Qin<int>::make(1);
+    auto view   = Qin<int>::make(0);
+    view << source;
+
+    *source = 2;
+    ASSERT_I(view->get(), 2);
+
+    *view = 9; // binding is one-way: source keeps its value
+    ASSERT_I(view->get(), 9);
+    ASSERT_I(source->get(), 2);
+
+    *source = 3; // the next source write is followed again
+    ASSERT_I(view->get(), 3);
+
+    return 0;
+}
+
+int test_bind_chain() {
+    auto a = Qin<int>::make(0);
+    auto b = Qin<int>::make(0);
+    auto c = Qin<int>::make(0);
+    b << a;
+    c << b;
+
+    *a = 5;
+    ASSERT_I(c->get(), 5);
+
+    *b = 7; // c follows b, which now holds its own value
+    ASSERT_I(c->get(), 7);
+    ASSERT_I(a->get(), 5);
+
+    *a = 8;
+    ASSERT_I(b->get(), 8);
+    ASSERT_I(c->get(), 8);
+
+    return 0;
+}
+
+// ============================================================================
+// Dependents
+// ============================================================================
+
+int test_bind_dependents_update() {
+    auto source  = Qin<int>::make(1);
+    auto view    = Qin<int>::make(0);
+    view << source;
+    auto doubled = view * constant(2);
+
+    std::vector<int> seen;
+    auto sub = view->subscribe([&seen](int v) { seen.push_back(v); });
+
+    *source = 4;
+    ASSERT_I(doubled->get(), 8);
+    ASSERT_I(static_cast<int>(seen.size()), 1);
+    ASSERT_I(seen[0], 4);
+
+    return 0;
+}
+
+int test_bind_setter_keeps_copy() {
+    auto source = Yi<std::string, std::string>::make();
+    auto view   = Yi<std::string, std::string>::make();
+    int  calls  = 0;
+    view->setter([&calls](const std::string& s) {
+        ++calls;
+        return s + "!";
+    });
+    view << source;
+
+    *source = std::string("hi");
+    ASSERT_I(calls, 1);
+    ASSERT_S(view->get(), std::string("hi!"));
+    ASSERT_S(source->get(), std::string("hi"));
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // shared storage
+        test_bind_views_share_storage(),
+        test_bind_write_to_view_is_local(),
+        test_bind_chain(),
+        // dependents
+        test_bind_dependents_update(),
+        test_bind_setter_keeps_copy()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
@@ -0,0 +1,249 @@
+//
+// Test incremental checkpoints of source values
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace ZongHeng;
+
+struct Quote {
+    std::string symbol;
+    double      price;
+};
+
+template<>
+struct ZongHeng::Serializer<Quote> {
+    static void write(const Quote& q, std::string& out) {
+        Serializer<double>::write(q.price, out);
+        out.append(q.symbol);
+    }
+
+    static Quote read(const char* data, size_t size) {
+        return { std::string(data + sizeof(double), size - sizeof(double)),
+                 Serializer<double>::read(data, sizeof(double)) };
+    }
+};
+
+static const std::string kPath = "checkpoint_test.log";
+
+static void fresh() {
+    std::remove(kPath.c_str());
+}
+
+// ============================================================================
+// Incremental Writes
+// ============================================================================
+
+int test_checkpoint_writes_only_changes() {
+    fresh();
+    auto a = Qin<int>::make(1);
+    auto b = Qin<int>::make(2);
+
+    Checkpoint cp(kPath);
+    cp.track("a", a);
+    cp.track("b", b);
+
+    ASSERT_I(static_cast<int>(cp.checkpoint()), 2); // first checkpoint: everything
+    ASSERT_I(static_cast<int>(cp.checkpoint()), 0); // nothing changed
+
+    *a = 10;
+    ASSERT_I(static_cast<int>(cp.checkpoint()), 1);
+
+    auto size = cp.getLogSize();
+    ASSERT_I(static_cast<int>(cp.checkpoint()), 0);
+    ASSERT_I(cp.getLogSize() == size, true); // no empty commits
+
+    return 0;
+}
+
+int test_checkpoint_rejects_derived() {
+    fresh();
+    auto a   = Qin<int>::make(1);
+    auto sum = a + a;
+
+    Checkpoint cp(kPath);
+    try {
+        cp.track("sum", sum);
+    } catch (const std::runtime_error&) {
+        return 0;
+    }
+
+    printf("%s: expected runtime_error\n", __func__);
+    return -1;
+}
+
+// ============================================================================
+// Restore
+// ============================================================================
+
+int test_checkpoint_restore_after_restart() {
+    fresh();
+    {
+        auto price = Qin<double>::make(1.5);
+        auto name  = Qin<std::string>::make("apple");
+        auto quote = Qin<Quote>::make(Quote { "AAPL", 190.5 });
+
+        Checkpoint cp(kPath);
+        cp.track("price", price);
+        cp.track("name", name);
+        cp.track("quote", quote);
+        cp.checkpoint();
+
+        *price = 2.5;
+        *name  = std::string("pear");
+        cp.checkpoint();
+
+        *price = 99.0; // never checkpointed
+    }
+
+    // New process: new nodes, same keys
+    auto price = Qin<double>::make(0.0);
+    auto name  = Qin<std::string>::make("");
+    auto quote = Qin<Quote>::make(Quote { "", 0.0 });
+
+    Checkpoint cp(kPath);
+    cp.track("price", price);
+    cp.track("name", name);
+    cp.track("quote", quote);
+
+    ASSERT_I(static_cast<int>(cp.restore()), 3);
+    ASSERT_F(price->get(), 2.5);
+    ASSERT_S(name->get(), std::string("pear"));
+    ASSERT_S(quote->get().symbol, std::string("AAPL"));
+    ASSERT_F(quote->get().price, 190.5);
+
+    ASSERT_I(static_cast<int>(cp.checkpoint()), 0); // restored values are persisted
+
+    return 0;
+}
+
+int test_checkpoint_restore_propagates_once() {
+    fresh();
+    {
+        auto bid = Qin<int>::make(100);
+        auto ask = Qin<int>::make(105);
+        Checkpoint cp(kPath);
+        cp.track("bid", bid);
+        cp.track("ask", ask);
+        cp.checkpoint();
+    }
+
+    auto bid    = Qin<int>::make(0);
+    auto ask    = Qin<int>::make(0);
+    auto spread = ask - bid;
+
+    std::vector<int> seen;
+    auto sub = spread->subscribe([&seen](int v) { seen.push_back(v); });
+
+    Checkpoint cp(kPath);
+    cp.track("bid", bid);
+    cp.track("ask", ask);
+    cp.restore();
+
+    ASSERT_I(static_cast<int>(seen.size()), 1);
+    ASSERT_I(seen[0], 5);
+
+    return 0;
+}
+
+int test_checkpoint_ignores_torn_tail() {
+    fresh();
+    {
+        auto a = Qin<int>::make(7);
+        Checkpoint cp(kPath);
+        cp.track("a", a);
+        cp.checkpoint();
+        *a = 8;
+        cp.checkpoint();
+    }
+
+    // Simulate a crash in the middle of the next checkpoint
+    {
+        std::ofstream out(kPath, std::ios::binary | std::ios::app);
+        out << "\x02\x00\x00\x00\xff\x00\x00\x00partial";
+    }
+
+    auto a = Qin<int>::make(0);
+    Checkpoint cp(kPath);
+    cp.track("a", a);
+    cp.restore();
+    ASSERT_I(a->get(), 8);
+
+    *a = 9; // appends after the truncated tail
+    cp.checkpoint();
+
+    auto b = Qin<int>::make(0);
+    Checkpoint reopened(kPath);
+    reopened.track("a", b);
+    reopened.restore();
+    ASSERT_I(b->get(), 9);
+
+    return 0;
+}
+
+// ============================================================================
+// Compaction
+// ============================================================================
+
+int test_checkpoint_compaction() {
+    fresh();
+    auto a    = Qin<int>::make(0);
+    auto keep = Qin<int>::make(5);
+
+    {
+        Checkpoint cp(kPath);
+        cp.track("a", a);
+        cp.track("keep", keep);
+        cp.checkpoint();
+    }
+
+    Checkpoint cp(kPath, 2.0);
+    cp.track("a", a); // "keep" is not tracked by this process
+
+    for (int i = 1; i <= 1000; ++i) {
+        *a = i;
+        cp.checkpoint();
+    }
+    ASSERT_I(cp.getLogSize() < 2 * 4096 + 64, true); // compacted along the way
+
+    cp.compact();
+    auto compacted = cp.getLogSize();
+    ASSERT_I(compacted < 128, true);
+
+    auto a2    = Qin<int>::make(0);
+    auto keep2 = Qin<int>::make(0);
+    Checkpoint reopened(kPath);
+    reopened.track("a", a2);
+    reopened.track("keep", keep2);
+    reopened.restore();
+    ASSERT_I(a2->get(), 1000);
+    ASSERT_I(keep2->get(), 5); // untracked keys survive compaction
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // incremental writes
+        test_checkpoint_writes_only_changes(),
+        test_checkpoint_rejects_derived(),
+        // restore
+        test_checkpoint_restore_after_restart(),
+        test_checkpoint_restore_propagates_once(),
+        test_checkpoint_ignores_torn_tail(),
+        // compaction
+        test_checkpoint_compaction()
+    };
+
+    fresh();
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
@@ -6,6 +6,7 @@
 #include "ZongHeng.h"
 #include "test_utils.h"
 #include <string>
+#include <vector>
 
 using namespace ZongHeng;
 
@@ -140,6 +141,70 @@ int test_fold_multiply() {
     return 0;
 }
 
+// ============================================================================
+// combine / zip Tests
+// ============================================================================
+
+int test_combine_heterogeneous() {
+    auto qty   = Qin<int>::make(3);
+    auto price = Qin<double>::make(2.5);
+    auto name  = Qin<std::string>::make("apple");
+
+    auto line = combine(qty, price, name, [](int q, double p, const std::string& n) {
+        return n + ":" + std::to_string(static_cast<int>(q * p));
+    });
+
+    ASSERT_S(line->get(), std::string("apple:7"));
+
+    *qty = 4;
+    ASSERT_S(line->get(), std::string("apple:10"));
+
+    *name = std::string("pear");
+    ASSERT_S(line->get(), std::string("pear:10"));
+
+    return 0;
+}
+
+int test_combine_single_registration() {
+    auto a = Qin<int>::make(1);
+    auto b = Qin<double>::make(2.0);
+    auto c = Qin<bool>::make(true);
+
+    int  calls  = 0;
+    auto result = combine(a, b, c, a, [&calls](int x, double y, bool z, int w) {
+        ++calls;
+        return z ? x + y + w : 0.0;
+    });
+
+    ASSERT_I(static_cast<int>(a->getHengCount()), 1); // a passed twice, linked once
+    ASSERT_I(static_cast<int>(b->getHengCount()), 1);
+    ASSERT_I(static_cast<int>(c->getHengCount()), 1);
+
+    auto watch = result->observe();
+    calls = 0;
+
+    *a = 5;
+    ASSERT_I(calls, 1); // one recompute per change
+    ASSERT_F(result->get(), 12.0);
+    ASSERT_I(calls, 1); // read served from the cache
+
+    return 0;
+}
+
+int test_zip_tuple() {
+    auto id    = Qin<int>::make(7);
+    auto label = Qin<std::string>::make("seven");
+
+    auto both = zip(id, label);
+    ASSERT_I(std::get<0>(both->get()), 7);
+    ASSERT_S(std::get<1>(both->get()), std::string("seven"));
+
+    *id = 8;
+    ASSERT_I(std::get<0>(both->get()), 8);
+
+    return 0;
+}
+
 // ============================================================================
 // when Tests
 // ============================================================================
@@ -194,6 +259,69 @@ int test_when_reactive() {
     return 0;
 }
 
+int test_when_inactive_branch_cold() {
+    auto flag    = Qin<bool>::make(true);
+    auto optionA = Qin<int>::make(1);
+    auto optionB = Qin<int>::make(2);
+
+    int  recomputes = 0;
+    auto expensive  = optionB->map([&recomputes](int x) { ++recomputes; return x * 10; });
+
+    std::vector<int> seen;
+    auto selected = when(flag, optionA, expensive);
+    auto sub      = selected->subscribe([&seen](int v) { seen.push_back(v); });
+
+    ASSERT_I(static_cast<int>(expensive->getHengCount()), 0);
+    ASSERT_I(expensive->isHot(), false);
+
+    recomputes = 0;
+    *optionB   = 3; // inactive branch: no recompute, no notification
+    ASSERT_I(recomputes, 0);
+    ASSERT_I(static_cast<int>(seen.size()), 0);
+
+    *flag = false; // flip: expensive becomes the subscribed branch
+    ASSERT_I(selected->get(), 30);
+    ASSERT_I(expensive->isHot(), true);
+    ASSERT_I(optionA->isHot(), false);
+
+    *optionA = 5;
+    *optionB = 4;
+    ASSERT_I(static_cast<int>(seen.size()), 2);
+    ASSERT_I(seen[1], 40);
+
+    return 0;
+}
+
+// ============================================================================
+// select Tests
+// ============================================================================
+
+int test_select_branches() {
+    auto mode     = Qin<int>::make(0);
+    auto fast     = Qin<int>::make(1);
+    auto accurate = Qin<int>::make(2);
+    auto cached   = Qin<int>::make(3);
+    auto idle     = Qin<int>::make(-1);
+
+    auto output = select(mode, { fast, accurate, cached }, idle);
+    auto watch  = output->observe();
+    ASSERT_I(output->get(), 1);
+    ASSERT_I(accurate->isHot(), false);
+
+    *mode = 2;
+    ASSERT_I(output->get(), 3);
+    ASSERT_I(fast->isHot(), false);
+    ASSERT_I(cached->isHot(), true);
+
+    *cached = 30;
+    ASSERT_I(output->get(), 30);
+
+    *mode = 7; // out of range
+    ASSERT_I(output->get(), -1);
+
+    return 0;
+}
+
 // ============================================================================
 // Chainable API Tests
 // ============================================================================
@@ -274,10 +402,17 @@ int main() {
         test_fold_accumulate(),
         test_fold_reactive(),
         test_fold_multiply(),
+        // combine / zip
+        test_combine_heterogeneous(),
+        test_combine_single_registration(),
+        test_zip_tuple(),
         // when
         test_when_condition_true(),
         test_when_condition_false(),
         test_when_reactive(),
+        test_when_inactive_branch_cold(),
+        // select
+        test_select_branches(),
         // chainable API
         test_chainable_map(),
         test_chainable_map_filter(),
@@ -0,0 +1,124 @@
+//
+// Test computed nodes with automatic dependency capture
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace ZongHeng;
+
+// ============================================================================
+// Capture
+// ============================================================================
+
+int test_computed_captures_reads() {
+    auto a = Qin<int>::make(1);
+    auto b = Qin<int>::make(2);
+
+    auto sum = computed([a, b]() { return a->get() + b->get(); });
+    ASSERT_I(sum->get(), 3);
+    ASSERT_I(static_cast<int>(a->getHengCount()), 1);
+    ASSERT_I(static_cast<int>(b->getHengCount()), 1);
+
+    *b = 10;
+    ASSERT_I(sum->get(), 11);
+
+    return 0;
+}
+
+int test_computed_map_side_read() {
+    auto price = Qin<double>::make(2.0);
+    auto qty   = Qin<int>::make(3);
+
+    // A map() reading a second node misses its updates; computed() does not
+    auto total = computed([price, qty]() { return price->get() * qty->get(); });
+    auto watch = total->observe();
+
+    *qty = 4;
+    ASSERT_F(total->get(), 8.0);
+
+    return 0;
+}
+
+int test_computed_ignores_nested_reads() {
+    auto a   = Qin<int>::make(1);
+    auto b   = Qin<int>::make(2);
+    auto sum = a + b;
+
+    auto twice = computed([sum]() { return sum->get() * 2; });
+    ASSERT_I(twice->get(), 6);
+
+    // Only sum is a dependency: a and b are read by sum's own effect
+    ASSERT_I(static_cast<int>(a->getHengCount()), 1);
+    ASSERT_I(static_cast<int>(sum->getHengCount()), 1);
+
+    *a = 5;
+    ASSERT_I(twice->get(), 14);
+
+    return 0;
+}
+
+// ============================================================================
+// Dynamic Dependencies
+// ============================================================================
+
+int test_computed_switches_branches() {
+    auto useB = Qin<bool>::make(false);
+    auto a    = Qin<int>::make(1);
+    auto b    = Qin<int>::make(100);
+
+    std::vector<int> seen;
+    auto pick = computed([useB, a, b]() { return useB->get() ? b->get() : a->get(); });
+    auto sub  = pick->subscribe([&seen](int v) { seen.push_back(v); });
+
+    ASSERT_I(static_cast<int>(b->getHengCount()), 0); // untaken branch not subscribed
+    ASSERT_I(b->isHot(), false);
+
+    *useB = true;
+    ASSERT_I(pick->get(), 100);
+    ASSERT_I(static_cast<int>(a->getHengCount()), 0); // old branch dropped
+    ASSERT_I(static_cast<int>(b->getHengCount()), 1);
+    ASSERT_I(a->isHot(), false);
+    ASSERT_I(b->isHot(), true);
+
+    *a = 2; // no longer a dependency: no notification
+    *b = 200;
+    ASSERT_I(static_cast<int>(seen.size()), 2);
+    ASSERT_I(seen[0], 100);
+    ASSERT_I(seen[1], 200);
+
+    return 0;
+}
+
+int test_computed_chains() {
+    auto name     = Qin<std::string>::make("ada");
+    auto greeting = computed([name]() { return "hello " + name->get(); });
+    auto length   = computed([greeting]() { return static_cast<int>(greeting->get().size()); });
+    auto watch    = length->observe();
+
+    *name = std::string("grace");
+    ASSERT_S(greeting->get(), std::string("hello grace"));
+    ASSERT_I(length->get(), 11);
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // capture
+        test_computed_captures_reads(),
+        test_computed_map_side_read(),
+        test_computed_ignores_nested_reads(),
+        // dynamic dependencies
+        test_computed_switches_branches(),
+        test_computed_chains()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
@@ -0,0 +1,128 @@
+//
+// Test constant nodes and constant folding
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+using namespace ZongHeng;
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+int test_constant_is_immutable() {
+    auto two = constant(2);
+    ASSERT_I(two->get(), 2);
+    ASSERT_I(two->isConstant(), true);
+    ASSERT_I(two->getKind() == NodeKind::Constant, true);
+
+    try {
+        *two = 3;
+    } catch (const std::runtime_error&) {
+        ASSERT_I(two->get(), 2);
+        return 0;
+    }
+
+    printf("%s: expected runtime_error\n", __func__);
+    return -1;
+}
+
+int test_constant_bind_is_skipped() {
+    auto source = Qin<int>::make(1);
+    auto fixed  = constant(7);
+    fixed << source; // bound targets that reject writes are skipped
+
+    *source = 5;
+    ASSERT_I(fixed->get(), 7);
+
+    return 0;
+}
+
+// ============================================================================
+// Folding
+// ============================================================================
+
+int test_constant_folds_expressions() {
+    auto sum = constant(2) * constant(3) + constant(4);
+    ASSERT_I(sum->isConstant(), true);
+    ASSERT_I(sum->get(), 10);
+
+    auto less = constant(1.5) < constant(2.5);
+    ASSERT_I(less->isConstant(), true);
+    ASSERT_I(less->get(), true);
+
+    auto neg = -constant(9);
+    auto no  = !constant(0);
+    ASSERT_I(neg->isConstant(), true);
+    ASSERT_I(neg->get(), -9);
+    ASSERT_I(no->get(), true);
+
+    auto text = constant(std::string("ab")) + constant(std::string("cd"));
+    ASSERT_S(text->get(), std::string("abcd"));
+
+    return 0;
+}
+
+// ============================================================================
+// Scalar Kernels
+// ============================================================================
+
+int test_constant_scalar_operand() {
+    auto price = Qin<double>::make(4.0);
+    auto rate  = constant(0.5);
+    auto half  = price * rate;
+    auto left  = constant(10.0) - price; // constant on the left keeps its side
+
+    ASSERT_I(static_cast<int>(rate->getHengCount()), 0); // no edge to the constant
+    ASSERT_I(static_cast<int>(price->getHengCount()), 2);
+    ASSERT_I(half->isConstant(), false);
+    ASSERT_F(half->get(), 2.0);
+    ASSERT_F(left->get(), 6.0);
+
+    auto watch = half->observe();
+    *price = 8.0;
+    ASSERT_F(half->get(), 4.0);
+    ASSERT_F(left->get(), 2.0);
+
+    return 0;
+}
+
+int test_constant_with_freeze() {
+    auto qty   = Qin<int>::make(3);
+    auto total = qty * constant(4) + constant(1);
+
+    {
+        auto frozen = freeze({ total });
+        ASSERT_I(static_cast<int>(frozen->getStats().opcodes), 2);
+        *qty = 5;
+        ASSERT_I(total->get(), 21);
+    }
+
+    ASSERT_I(static_cast<int>(qty->getHengCount()), 1);
+    *qty = 6;
+    ASSERT_I(total->get(), 25);
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // constants
+        test_constant_is_immutable(),
+        test_constant_bind_is_skipped(),
+        // folding
+        test_constant_folds_expressions(),
+        // scalar kernels
+        test_constant_scalar_operand(),
+        test_constant_with_freeze()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
@@ -0,0 +1,133 @@
+//
+// Test incremental countIf / all / any
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+using namespace ZongHeng;
+
+static std::vector<std::shared_ptr<Qin<bool>>> flags(size_t n, bool value) {
+    std::vector<std::shared_ptr<Qin<bool>>> out;
+    for (size_t i = 0; i < n; ++i) {
+        out.push_back(Qin<bool>::make(value));
+    }
+    return out;
+}
+
+// ============================================================================
+// countIf
+// ============================================================================
+
+int test_count_if() {
+    auto a = Qin<int>::make(1);
+    auto b = Qin<int>::make(50);
+    auto c = Qin<int>::make(100);
+
+    auto high = countIf<int>({ a, b, c }, [](int v) { return v > 10; });
+    ASSERT_I(static_cast<int>(high->get()), 2);
+
+    *a = 20;
+    ASSERT_I(static_cast<int>(high->get()), 3);
+    *c = 0;
+    *b = 5;
+    ASSERT_I(static_cast<int>(high->get()), 1);
+
+    return 0;
+}
+
+int test_count_if_duplicate_input() {
+    auto a = Qin<int>::make(1);
+
+    auto positive = countIf<int>({ a, a }, [](int v) { return v > 0; });
+    ASSERT_I(static_cast<int>(positive->get()), 2);
+    ASSERT_I(static_cast<int>(a->getHengCount()), 1); // one edge per distinct input
+
+    *a = -1;
+    ASSERT_I(static_cast<int>(positive->get()), 0);
+
+    return 0;
+}
+
+int test_count_if_derived_inputs() {
+    auto price = Qin<int>::make(10);
+    auto limit = Qin<int>::make(15);
+    auto over  = price > limit;
+    auto under = price < limit;
+
+    auto n = countIf<bool>({ over, under }, [](bool v) { return v; });
+    ASSERT_I(static_cast<int>(n->get()), 1);
+
+    *price = 15; // neither
+    ASSERT_I(static_cast<int>(n->get()), 0);
+
+    return 0;
+}
+
+// ============================================================================
+// all / any
+// ============================================================================
+
+int test_all_any() {
+    auto checks = flags(1000, true);
+    auto ready  = all(checks);
+    auto alarm  = any(checks);
+
+    ASSERT_I(ready->get(), true);
+    ASSERT_I(alarm->get(), true);
+
+    *checks[500] = false;
+    ASSERT_I(ready->get(), false);
+    ASSERT_I(alarm->get(), true);
+
+    for (auto& check : checks) {
+        *check = false;
+    }
+    ASSERT_I(alarm->get(), false);
+
+    *checks[0] = true;
+    ASSERT_I(alarm->get(), true);
+
+    ASSERT_I(all(flags(0, false))->get(), true);
+    ASSERT_I(any(flags(0, true))->get(), false);
+
+    return 0;
+}
+
+int test_all_notifies_on_flip_only() {
+    auto checks = flags(100, false);
+    auto ready  = all(checks);
+
+    std::vector<bool> seen;
+    auto sub = ready->subscribe([&seen](bool v) { seen.push_back(v); });
+
+    for (size_t i = 0; i + 1 < checks.size(); ++i) {
+        *checks[i] = true; // count moves, result does not
+    }
+    ASSERT_I(static_cast<int>(seen.size()), 0);
+
+    *checks.back() = true;
+    ASSERT_I(static_cast<int>(seen.size()), 1);
+    ASSERT_I(seen[0], true);
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // countIf
+        test_count_if(),
+        test_count_if_duplicate_input(),
+        test_count_if_derived_inputs(),
+        // all / any
+        test_all_any(),
+        test_all_notifies_on_flip_only()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
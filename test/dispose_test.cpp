@@ -0,0 +1,245 @@
+//
+// Test dispose() and unlink(): removing nodes and bindings from the graph
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+using namespace ZongHeng;
+
+// ============================================================================
+// dispose()
+// ============================================================================
+
+int test_dispose_stops_recompute() {
+    auto a     = Qin<int>::make(1);
+    int  calls = 0;
+    auto view  = a->map([&calls](int v) {
+        ++calls;
+        return v * 10;
+    });
+    auto watch = view->observe();
+    ASSERT_I(view->get(), 10);
+    ASSERT_I(static_cast<int>(a->getHengCount()), 1);
+
+    view->dispose();
+    ASSERT_I(view->isDisposed(), true);
+    ASSERT_I(static_cast<int>(a->getHengCount()), 0);
+
+    calls = 0;
+    *a    = 5;
+    ASSERT_I(calls, 0);
+    ASSERT_I(view->get(), 10); // keeps its last value
+
+    return 0;
+}
+
+int test_dispose_releases_upstream() {
+    auto a   = Qin<int>::make(1);
+    auto b   = Qin<int>::make(2);
+    auto sum = a + b;
+    auto sub = sum->subscribe([](int) { });
+    ASSERT_I(a->isHot(), true);
+
+    sum->dispose();
+    ASSERT_I(a->isHot(), false);
+    ASSERT_I(b->isHot(), false);
+    ASSERT_I(sum->isHot(), true); // still subscribed
+
+    return 0;
+}
+
+int test_dispose_settles_stale_value() {
+    auto a   = Qin<int>::make(1);
+    auto sum = a + a;
+    *a       = 4; // sum is cold: only marked dirty
+
+    sum->dispose();
+    ASSERT_I(sum->get(), 8);
+
+    return 0;
+}
+
+int test_dispose_keeps_dependents() {
+    auto a       = Qin<int>::make(1);
+    auto b       = Qin<int>::make(2);
+    auto sum     = a + b;
+    auto doubled = sum * constant(2);
+    ASSERT_I(doubled->get(), 6);
+
+    sum->dispose(); // sum now acts as a source for doubled
+    *a = 10;
+    ASSERT_I(doubled->get(), 6);
+
+    *sum = 7;
+    ASSERT_I(doubled->get(), 14);
+    ASSERT_I(static_cast<int>(sum->getHengCount()), 1);
+
+    return 0;
+}
+
+int test_dispose_compacts_fan_out() {
+    auto a = Qin<int>::make(0);
+    std::vector<std::shared_ptr<Qin<int>>> views;
+    for (int i = 0; i < 100; ++i) {
+        views.push_back(a->map([i](int v) { return v + i; }));
+    }
+
+    for (int i = 0; i < 60; ++i) {
+        views[i]->dispose();
+    }
+    ASSERT_I(static_cast<int>(a->getHengCount()), 40);
+    ASSERT_I(a->getHeng().size() < 100, true); // emptied entries were compacted
+
+    *a = 1;
+    ASSERT_I(views[60]->get(), 61);
+    ASSERT_I(views[99]->get(), 100);
+    ASSERT_I(views[0]->get(), 0);
+
+    // Disconnecting after compaction still finds the right entry
+    views[99]->dispose();
+    *a = 2;
+    ASSERT_I(views[98]->get(), 100);
+    ASSERT_I(views[99]->get(), 100);
+    ASSERT_I(static_cast<int>(a->getHengCount()), 39);
+
+    return 0;
+}
+
+int test_dispose_deferred_in_pass() {
+    auto a    = Qin<int>::make(1);
+    auto view = a->map([](int v) { return v + 1; });
+    {
+        Batch batch;
+        view->dispose();
+        ASSERT_I(view->isDisposed(), false); // edges change when the pass ends
+    }
+    ASSERT_I(view->isDisposed(), true);
+    ASSERT_I(static_cast<int>(a->getHengCount()), 0);
+
+    return 0;
+}
+
+int test_dispose_expr_table() {
+    auto& exprs = ExprTable::global();
+    exprs.clear();
+    exprs.enable();
+
+    auto a = Qin<int>::make(1);
+    auto b = Qin<int>::make(2);
+    auto x = a + b;
+    x->dispose();
+    auto y = a + b; // a disposed node is not shared
+    exprs.disable();
+    exprs.clear();
+
+    ASSERT_I(x.get() != y.get(), true);
+    *a = 5;
+    ASSERT_I(y->get(), 7);
+
+    return 0;
+}
+
+int test_dispose_frozen_throws() {
+    auto a      = Qin<int>::make(1);
+    auto sum    = a + a;
+    auto frozen = freeze({ sum });
+    try {
+        sum->dispose();
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+    ASSERT_I(sum->isDisposed(), false);
+
+    return 0;
+}
+
+// ============================================================================
+// unlink()
+// ============================================================================
+
+int test_unlink_binding() {
+    auto source = Qin<int>::make(1);
+    auto view   = Qin<int>::make(0);
+    view << source;
+    ASSERT_I(source->isHot(), true);
+
+    *source = 2;
+    view->unlink(source);
+    ASSERT_I(source->isHot(), false);
+    ASSERT_I(static_cast<int>(source->getZongCount()), 0);
+
+    *source = 3;
+    ASSERT_I(view->get(), 2); // shared storage was copied on unlink
+
+    view << source; // can be bound again
+    *source = 4;
+    ASSERT_I(view->get(), 4);
+
+    return 0;
+}
+
+int test_unlink_keeps_other_bindings() {
+    auto source = Qin<int>::make(0);
+    std::vector<std::shared_ptr<Qin<int>>> views;
+    for (int i = 0; i < 4; ++i) {
+        views.push_back(Qin<int>::make(0));
+        views.back() << source;
+    }
+
+    views[0]->unlink(source);
+    views[2]->unlink(source);
+    *source = 9;
+    ASSERT_I(views[0]->get(), 0);
+    ASSERT_I(views[1]->get(), 9);
+    ASSERT_I(views[2]->get(), 0);
+    ASSERT_I(views[3]->get(), 9);
+    ASSERT_I(static_cast<int>(source->getZongCount()), 2);
+
+    return 0;
+}
+
+int test_dispose_cuts_bindings() {
+    auto source = Qin<int>::make(1);
+    auto mirror = Qin<int>::make(0);
+    auto copy   = Qin<int>::make(0);
+    mirror << source;
+    copy << mirror;
+
+    *source = 3;
+    mirror->dispose();
+    *source = 5;
+    ASSERT_I(mirror->get(), 3);
+    ASSERT_I(copy->get(), 3);
+    ASSERT_I(source->isHot(), false);
+
+    *mirror = 8; // nothing is bound to it any more
+    ASSERT_I(copy->get(), 3);
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // dispose()
+        test_dispose_stops_recompute(),
+        test_dispose_releases_upstream(),
+        test_dispose_settles_stale_value(),
+        test_dispose_keeps_dependents(),
+        test_dispose_compacts_fan_out(),
+        test_dispose_deferred_in_pass(),
+        test_dispose_expr_table(),
+        test_dispose_frozen_throws(),
+        // unlink()
+        test_unlink_binding(),
+        test_unlink_keeps_other_bindings(),
+        test_dispose_cuts_bindings()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
@@ -0,0 +1,155 @@
+//
+// Test sharing of identical operator nodes (ExprTable)
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace ZongHeng;
+
+// ============================================================================
+// Sharing
+// ============================================================================
+
+int test_expr_disabled_by_default() {
+    auto& exprs = ExprTable::global();
+    exprs.clear();
+    ASSERT_I(exprs.isEnabled(), false);
+
+    auto a = Qin<int>::make(1);
+    auto b = Qin<int>::make(2);
+    auto x = a + b;
+    auto y = a + b;
+    ASSERT_I(x.get() == y.get(), false); // distinct nodes
+    ASSERT_I(static_cast<int>(exprs.getStats().lookups), 0);
+
+    return 0;
+}
+
+int test_expr_shares_identical_nodes() {
+    auto& exprs = ExprTable::global();
+    exprs.clear();
+    exprs.enable();
+
+    auto a = Qin<int>::make(1);
+    auto b = Qin<int>::make(2);
+
+    auto x = a + b;
+    auto y = a + b;
+    auto z = b + a; // commutative: same node
+    auto d = a - b;
+    auto e = b - a; // not commutative
+    ASSERT_I(x.get() == y.get(), true);
+    ASSERT_I(x.get() == z.get(), true);
+    ASSERT_I(d.get() == e.get(), false);
+
+    auto lt1 = a < b;
+    auto lt2 = a < b;
+    auto eq  = b == a;
+    auto eq2 = a == b;
+    auto n1  = -a;
+    auto n2  = -a;
+    ASSERT_I(lt1.get() == lt2.get(), true);
+    ASSERT_I(eq.get() == eq2.get(), true);
+    ASSERT_I(n1.get() == n2.get(), true);
+
+    auto stats = exprs.getStats();
+    ASSERT_I(static_cast<int>(stats.lookups), 11);
+    ASSERT_I(static_cast<int>(stats.hits), 5);
+    ASSERT_I(static_cast<int>(stats.entries), 6);
+
+    *a = 10;
+    ASSERT_I(z->get(), 12);
+    ASSERT_I(e->get(), -8);
+    ASSERT_I(lt2->get(), false);
+
+    exprs.disable();
+    return 0;
+}
+
+int test_expr_nested_expressions() {
+    auto& exprs = ExprTable::global();
+    exprs.clear();
+    exprs.enable();
+
+    auto a = Qin<double>::make(1.5);
+    auto b = Qin<double>::make(2.0);
+    auto c = Qin<double>::make(4.0);
+
+    auto f1 = (a + b) * c;
+    auto f2 = c * (b + a); // whole tree shared
+    ASSERT_I(f1.get() == f2.get(), true);
+    ASSERT_F(f2->get(), 14.0);
+
+    // Strings: + is not commutative
+    auto s = Qin<std::string>::make("x");
+    auto t = Qin<std::string>::make("y");
+    auto st = s + t;
+    auto ts = t + s;
+    ASSERT_I(st.get() == ts.get(), false);
+    ASSERT_S(ts->get(), std::string("yx"));
+
+    exprs.disable();
+    return 0;
+}
+
+// ============================================================================
+// Node count
+// ============================================================================
+
+int test_expr_fewer_nodes() {
+    auto& exprs = ExprTable::global();
+    auto& nodes = NodeRegistry::global();
+    exprs.clear();
+
+    auto a = Qin<long>::make(1);
+    auto b = Qin<long>::make(2);
+    std::vector<std::shared_ptr<Qin<long>>> weights;
+    for (long i = 0; i < 8; ++i) {
+        weights.push_back(Qin<long>::make(i));
+    }
+
+    auto before = nodes.size();
+    for (auto& w : weights) {
+        auto formula = (a + b) * w; // a + b built 8 times
+    }
+    auto plain = nodes.size() - before;
+
+    exprs.enable();
+    before = nodes.size();
+    std::vector<std::shared_ptr<Qin<long>>> formulas;
+    for (auto& w : weights) {
+        formulas.push_back((a + b) * w);
+    }
+    auto shared = nodes.size() - before;
+
+    ASSERT_I(static_cast<int>(plain), 16);
+    ASSERT_I(static_cast<int>(shared), 9); // one a + b, eight products
+    ASSERT_I(static_cast<int>(exprs.getStats().hits), 7);
+
+    *a = 5;
+    ASSERT_I(static_cast<int>(formulas[3]->get()), 21);
+
+    exprs.disable();
+    exprs.clear();
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // sharing
+        test_expr_disabled_by_default(),
+        test_expr_shares_identical_nodes(),
+        test_expr_nested_expressions(),
+        // node count
+        test_expr_fewer_nodes()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
@@ -0,0 +1,159 @@
+//
+// Test freezing a graph into an instruction tape
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace ZongHeng;
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+int test_freeze_compiles_operators() {
+    auto price = Qin<double>::make(2.0);
+    auto qty   = Qin<double>::make(3.0);
+    auto fee   = Qin<double>::make(1.0);
+    auto total = price * qty + fee;
+    auto big   = total > Qin<double>::make(10.0);
+    auto label = total->map([](double t) { return t * 100.0; });
+
+    auto frozen = freeze({ big, label });
+    auto stats  = frozen->getStats();
+    ASSERT_I(static_cast<int>(stats.ops), 4);     // *, +, >, map
+    ASSERT_I(static_cast<int>(stats.opcodes), 3);
+    ASSERT_I(static_cast<int>(stats.calls), 1);
+    ASSERT_I(static_cast<int>(stats.inputs), 4);  // price, qty, fee, constant 10
+
+    ASSERT_F(total->get(), 7.0);
+    *qty = 4.0;
+    ASSERT_F(total->get(), 9.0);
+    ASSERT_I(big->get(), false);
+    ASSERT_F(label->get(), 900.0);
+
+    *price = 3.0;
+    ASSERT_I(big->get(), true);
+    ASSERT_F(label->get(), 1300.0);
+
+    return 0;
+}
+
+int test_freeze_visits_dirty_range_only() {
+    auto a = Qin<int>::make(1);
+    auto b = Qin<int>::make(2);
+    auto c = Qin<int>::make(3);
+
+    auto ab  = a + b;
+    auto abc = ab * c;
+    auto bc  = b - c;
+    auto sum = abc + bc;
+
+    auto frozen = freeze({ sum });
+    ASSERT_I(static_cast<int>(frozen->getStats().ops), 4);
+
+    *c = 4; // ab is clean: abc, bc, sum
+    ASSERT_I(static_cast<int>(frozen->getStats().lastVisited), 3);
+    ASSERT_I(sum->get(), 3 * 4 + (2 - 4));
+
+    *a = 1; // same value: ab does not change, nothing downstream runs
+    ASSERT_I(static_cast<int>(frozen->getStats().lastVisited), 1);
+
+    {
+        Batch batch; // several writes, one sweep
+        *a = 10;
+        *b = 20;
+    }
+    ASSERT_I(static_cast<int>(frozen->getStats().lastVisited), 4);
+    ASSERT_I(sum->get(), 30 * 4 + (20 - 4));
+
+    return 0;
+}
+
+// ============================================================================
+// Handles
+// ============================================================================
+
+int test_freeze_handles_keep_working() {
+    auto a   = Qin<int>::make(1);
+    auto b   = Qin<int>::make(2);
+    auto sum = a + b;
+
+    std::vector<int> seen;
+    auto sub = sum->subscribe([&seen](int v) { seen.push_back(v); });
+
+    auto frozen  = freeze({ sum });
+    auto doubled = sum->map([](int x) { return x * 2; }); // built on a frozen node
+    auto watch   = doubled->observe();
+
+    *a = 5;
+    ASSERT_I(sum->get(), 7);
+    ASSERT_I(doubled->get(), 14);
+    ASSERT_I(static_cast<int>(seen.size()), 1);
+    ASSERT_I(seen[0], 7);
+
+    return 0;
+}
+
+int test_freeze_boundaries() {
+    auto flag = Qin<bool>::make(true);
+    auto x    = Qin<int>::make(1);
+    auto y    = Qin<int>::make(2);
+    auto pick = when(flag, x, y);           // dynamic edges: an input of the tape
+    auto name = Qin<std::string>::make("");  // unregistered type: an input
+    auto len  = name->map([](const std::string& s) { return static_cast<int>(s.size()); });
+    auto out  = pick + len;
+
+    auto frozen = freeze({ out });
+    auto stats  = frozen->getStats();
+    ASSERT_I(static_cast<int>(stats.ops), 2); // len (call slot), out
+    ASSERT_I(static_cast<int>(stats.opcodes), 1);
+
+    *flag = false;
+    ASSERT_I(out->get(), 2);
+    *y = 7;
+    ASSERT_I(out->get(), 7);
+    *name = std::string("four");
+    ASSERT_I(out->get(), 11);
+
+    return 0;
+}
+
+int test_freeze_thaw() {
+    auto a   = Qin<int>::make(1);
+    auto b   = Qin<int>::make(2);
+    auto sum = a + b;
+
+    {
+        auto frozen = freeze({ sum });
+        ASSERT_I(static_cast<int>(a->getHengCount()), 0); // driven by the tape
+        *a = 3;
+    }
+
+    ASSERT_I(static_cast<int>(a->getHengCount()), 1);
+    ASSERT_I(sum->get(), 5);
+    *b = 10;
+    ASSERT_I(sum->get(), 13);
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // compilation
+        test_freeze_compiles_operators(),
+        test_freeze_visits_dirty_range_only(),
+        // handles
+        test_freeze_handles_keep_working(),
+        test_freeze_boundaries(),
+        test_freeze_thaw()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
@@ -0,0 +1,151 @@
+//
+// Test post(): writes from producer threads applied by Ingest::drain()
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ZongHeng;
+
+// ============================================================================
+// Conflation
+// ============================================================================
+
+int test_post_applied_on_drain() {
+    auto& ingest = Ingest::global();
+    auto  a      = Qin<int>::make(0);
+
+    a->post(1);
+    a->post(2);
+    a->post(3);
+    ASSERT_I(a->get(), 0); // nothing applied before the drain
+    ASSERT_I(ingest.hasPending(), true);
+
+    ASSERT_I(static_cast<int>(ingest.drain()), 1); // only the latest value
+    ASSERT_I(a->get(), 3);
+    ASSERT_I(ingest.hasPending(), false);
+    ASSERT_I(static_cast<int>(ingest.drain()), 0);
+
+    return 0;
+}
+
+int test_post_one_pass_per_drain() {
+    auto& ingest = Ingest::global();
+    auto  a      = Qin<int>::make(0);
+    auto  b      = Qin<int>::make(0);
+    int   calls  = 0;
+    auto  sum    = a->map([&calls](int v) {
+        ++calls;
+        return v;
+    }) + b;
+
+    std::vector<int> seen;
+    auto sub = sum->subscribe([&seen](int v) { seen.push_back(v); });
+
+    calls = 0;
+    for (int i = 1; i <= 100; ++i) {
+        a->post(i);
+        b->post(i * 10);
+    }
+    ingest.drain();
+
+    ASSERT_I(calls, 1); // the burst collapsed into one write of a
+    ASSERT_I(static_cast<int>(seen.size()), 1);
+    ASSERT_I(seen[0], 1100);
+
+    return 0;
+}
+
+int test_post_converts_and_rejects() {
+    auto& ingest = Ingest::global();
+    auto  text   = Qin<std::string>::make();
+    auto  fixed  = constant(5);
+
+    text->post("hello");
+    ingest.drain();
+    ASSERT_S(text->get(), std::string("hello"));
+
+    fixed->post(6); // rejected on the graph thread, like set()
+    ASSERT_I(static_cast<int>(ingest.drain()), 0);
+    ASSERT_I(fixed->get(), 5);
+
+    return 0;
+}
+
+// ============================================================================
+// Threads
+// ============================================================================
+
+int test_post_many_producers() {
+    auto& ingest = Ingest::global();
+    const int producers = 4;
+    const int posts     = 20000;
+
+    std::vector<std::shared_ptr<Qin<int>>> feeds;
+    for (int t = 0; t < producers; ++t) {
+        feeds.push_back(Qin<int>::make(-1));
+    }
+    auto shared = Qin<int>::make(-1);
+
+    std::atomic<int> wakes { 0 };
+    ingest.onPending([&wakes]() { wakes.fetch_add(1); });
+
+    std::atomic<int> done { 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < producers; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < posts; ++i) {
+                feeds[t]->post(i);
+                shared->post(t * posts + i);
+            }
+            done.fetch_add(1);
+        });
+    }
+
+    // Graph thread: values only ever move forward
+    std::vector<int> last(producers, -1);
+    bool ordered = true;
+    while (done.load() < producers || ingest.hasPending()) {
+        ingest.drain();
+        for (int t = 0; t < producers; ++t) {
+            int v = feeds[t]->get();
+            ordered = ordered && v >= last[t];
+            last[t] = v;
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ingest.drain();
+    ingest.onPending(nullptr);
+
+    ASSERT_I(ordered, true);
+    for (int t = 0; t < producers; ++t) {
+        ASSERT_I(feeds[t]->get(), posts - 1);
+    }
+    ASSERT_I(shared->get() % posts, posts - 1); // some producer's last post
+    ASSERT_I(wakes.load() > 0, true);
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // conflation
+        test_post_applied_on_drain(),
+        test_post_one_pass_per_drain(),
+        test_post_converts_and_rejects(),
+        // threads
+        test_post_many_producers()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
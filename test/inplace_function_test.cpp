@@ -0,0 +1,143 @@
+//
+// Test the inline-storage callable used by nodes
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+using namespace ZongHeng;
+
+// ============================================================================
+// Calls
+// ============================================================================
+
+static int twice(int x) {
+    return x * 2;
+}
+
+int test_inplace_calls() {
+    InplaceFunction<int(int)> empty;
+    ASSERT_I(static_cast<bool>(empty), false);
+
+    InplaceFunction<int(int)> fn = twice;
+    ASSERT_I(static_cast<bool>(fn), true);
+    ASSERT_I(fn(21), 42);
+
+    int offset = 3;
+    fn = [offset](int x) { return x + offset; };
+    ASSERT_I(fn(4), 7);
+
+    int (*none)(int) = nullptr;
+    fn = none; // null function pointer: stays empty, like std::function
+    ASSERT_I(static_cast<bool>(fn), false);
+
+    return 0;
+}
+
+int test_inplace_empty_throws() {
+    InplaceFunction<int()> fn;
+
+    try {
+        fn();
+    } catch (const std::bad_function_call&) {
+        return 0;
+    }
+
+    printf("%s: expected bad_function_call\n", __func__);
+    return -1;
+}
+
+// ============================================================================
+// Ownership
+// ============================================================================
+
+int test_inplace_copy_and_move() {
+    auto counter = std::make_shared<int>(0);
+
+    InplaceFunction<int()> a = [counter]() { return ++*counter; };
+    ASSERT_I(static_cast<int>(counter.use_count()), 2);
+
+    InplaceFunction<int()> b = a; // copies the capture
+    ASSERT_I(static_cast<int>(counter.use_count()), 3);
+
+    InplaceFunction<int()> c = std::move(a); // moves it
+    ASSERT_I(static_cast<int>(counter.use_count()), 3);
+    ASSERT_I(static_cast<bool>(a), false);
+
+    ASSERT_I(b(), 1);
+    ASSERT_I(c(), 2);
+
+    b = nullptr;
+    c = nullptr;
+    ASSERT_I(static_cast<int>(counter.use_count()), 1); // captures destroyed
+
+    return 0;
+}
+
+int test_inplace_capacity() {
+    auto p = std::make_shared<int>(1);
+    auto q = std::make_shared<int>(2);
+    auto op = [p, q]() { return *p + *q; };
+
+    // Operator effects capture two shared_ptrs: stored inline
+    ASSERT_I(InplaceFunction<int()>::fits<decltype(op)>, true);
+
+    std::string s1, s2;
+    auto big = [s1, s2]() { return s1.size() + s2.size(); };
+    ASSERT_I((InplaceFunction<size_t(), 32>::fits<decltype(big)>), false);
+    ASSERT_I((InplaceFunction<size_t(), 64>::fits<decltype(big)>), true);
+
+    return 0;
+}
+
+// ============================================================================
+// Nodes
+// ============================================================================
+
+int test_inplace_node_callables() {
+    auto a = Qin<int>::make(2);
+    auto b = Qin<int>::make(3);
+
+    auto product = a * b;
+    ASSERT_I(product->get(), 6);
+
+    auto text = Yi<int, std::string>::make(7);
+    text->getter([](const int& v) { return std::to_string(v); });
+    text->setter([](const std::string& s) { return std::stoi(s); });
+    ASSERT_S(text->get(), std::string("7"));
+
+    *text = std::string("12");
+    ASSERT_S(text->get(), std::string("12"));
+
+    // Oversized captures are boxed once instead of failing to compile
+    std::string prefix = "value: ", suffix = " units";
+    text->getter([prefix, suffix](const int& v) { return prefix + std::to_string(v) + suffix; });
+    ASSERT_S(text->get(), std::string("value: 12 units"));
+
+    a->hook(); // clears both hooks
+    *a = 5;
+    ASSERT_I(product->get(), 15);
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // calls
+        test_inplace_calls(),
+        test_inplace_empty_throws(),
+        // ownership
+        test_inplace_copy_and_move(),
+        test_inplace_capacity(),
+        // nodes
+        test_inplace_node_callables()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
@@ -0,0 +1,156 @@
+//
+// Test fusion of map() chains (MapNode)
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace ZongHeng;
+
+// ============================================================================
+// Fusion
+// ============================================================================
+
+int test_map_chain_fuses() {
+    auto value = Qin<int>::make(1);
+    int  calls = 0;
+
+    auto out = value->map([&calls](int x) { ++calls; return x + 1; })
+                    ->map([&calls](int x) { ++calls; return x * 10; })
+                    ->map([&calls](int x) { ++calls; return std::to_string(x); });
+
+    ASSERT_I(static_cast<int>(value->getHengCount()), 1); // only the last stage
+    ASSERT_I(out->getKind() == NodeKind::Map, true);
+    ASSERT_S(out->get(), std::string("20"));
+    ASSERT_I(calls, 3);
+
+    auto watch = out->observe();
+    calls = 0;
+    *value = 4;
+    ASSERT_I(calls, 3); // one recompute runs every stage once
+    ASSERT_S(out->get(), std::string("50"));
+    ASSERT_I(calls, 3);
+
+    return 0;
+}
+
+int test_map_deep_chain_one_edge() {
+    auto value = Qin<int>::make(0);
+    auto node  = value->map([](int x) { return x + 1; });
+    for (int i = 1; i < 100; ++i) {
+        node = node->map([](int x) { return x + 1; });
+    }
+
+    ASSERT_I(static_cast<int>(value->getHengCount()), 1);
+
+    std::vector<int> seen;
+    auto sub = node->subscribe([&seen](int v) { seen.push_back(v); });
+    *value = 10;
+    *value = 20;
+    ASSERT_I(static_cast<int>(seen.size()), 2);
+    ASSERT_I(seen[1], 120);
+
+    return 0;
+}
+
+int test_map_unary_fuses() {
+    auto value = Qin<int>::make(3);
+    auto neg   = -value->map([](int x) { return x * 2; });
+    auto no    = !value->map([](int x) { return x - 3; });
+
+    ASSERT_I(static_cast<int>(value->getHengCount()), 2);
+    ASSERT_I(neg->get(), -6);
+    ASSERT_I(no->get(), true);
+
+    *value = 5;
+    ASSERT_I(neg->get(), -10);
+    ASSERT_I(no->get(), false);
+
+    auto plain = -value; // not a chain: still a Neg node
+    ASSERT_I(plain->getKind() == NodeKind::Neg, true);
+
+    return 0;
+}
+
+// ============================================================================
+// Intermediate Stages
+// ============================================================================
+
+int test_map_detached_stage_reads() {
+    auto value = Qin<int>::make(2);
+    auto mid   = value->map([](int x) { return x * x; });
+    auto last  = mid->map([](int x) { return x + 1; });
+
+    ASSERT_I(static_cast<int>(value->getHengCount()), 1);
+    ASSERT_I(mid->get(), 4); // recomputed on read
+    *value = 3;
+    ASSERT_I(mid->get(), 9);
+    ASSERT_I(last->get(), 10);
+
+    return 0;
+}
+
+int test_map_stage_materializes() {
+    auto value = Qin<int>::make(1);
+    int  calls = 0;
+    auto mid   = value->map([&calls](int x) { ++calls; return x * 3; });
+    auto last  = mid->map([](int x) { return x + 1; });
+    auto watch = last->observe();
+
+    // Subscribing reconnects the stage; the next stage reads its cache
+    std::vector<int> seen;
+    auto sub = mid->subscribe([&seen](int v) { seen.push_back(v); });
+    ASSERT_I(static_cast<int>(value->getHengCount()), 2);
+
+    calls = 0;
+    *value = 2;
+    ASSERT_I(static_cast<int>(seen.size()), 1);
+    ASSERT_I(seen[0], 6);
+    ASSERT_I(last->get(), 7);
+    ASSERT_I(calls, 1);
+
+    // Deriving from a detached stage reconnects it as well
+    auto inner = value->map([](int x) { return x - 1; });
+    auto outer = inner->map([](int x) { return x * 2; });
+    auto other = Qin<int>::make(100);
+    auto sum   = inner + other;
+    *value = 6;
+    ASSERT_I(sum->get(), 105);
+    ASSERT_I(outer->get(), 10);
+
+    return 0;
+}
+
+int test_map_stage_with_getter() {
+    auto value = Qin<int>::make(1);
+    auto mid   = value->map([](int x) { return x + 1; });
+    mid->getter([](const int& v) { return v * 100; });
+    auto last = mid->map([](int x) { return x + 1; });
+
+    ASSERT_I(last->get(), 201); // sees the stage's getter
+    *value = 2;
+    ASSERT_I(last->get(), 301);
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // fusion
+        test_map_chain_fuses(),
+        test_map_deep_chain_one_edge(),
+        test_map_unary_fuses(),
+        // intermediate stages
+        test_map_detached_stage_reads(),
+        test_map_stage_materializes(),
+        test_map_stage_with_getter()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
@@ -5,6 +5,7 @@
 
 #include "ZongHeng.h"
 #include "test_utils.h"
+#include <cmath>
 
 // ============================================================================
 // Arithmetic Operators Tests
@@ -278,6 +279,48 @@ int test_zong_heng_accessors() {
     return 0;
 }
 
+// ============================================================================
+// Compile-Time Effect Nodes
+// ============================================================================
+
+int test_operator_node_type() {
+    auto a = Qin<int>::make(6);
+    auto b = Qin<int>::make(7);
+    auto product = a * b;
+
+    using Mul = Qin<int, std::multiplies<int>>;
+    ASSERT_I(dynamic_cast<Mul*>(product.get()) != nullptr, true);
+    ASSERT_I(product->get(), 42);
+
+    // Usable anywhere a Qin<int> is: chained, folded, converted
+    auto doubled = product->map([](int x) { return x * 2; });
+    auto total   = ZongHeng::fold<int>({ product, a }, 0, [](int acc, int x) { return acc + x; });
+    auto& ref    = product->into_ref<int, int>();
+    *b = 8;
+    ASSERT_I(doubled->get(), 96);
+    ASSERT_I(total->get(), 54);
+    ASSERT_I(ref.get(), 48);
+
+    return 0;
+}
+
+struct Hypot {
+    double operator()(double x, double y) const { return std::sqrt(x * x + y * y); }
+};
+
+int test_operator_node_custom_functor() {
+    auto x = Qin<double>::make(3.0);
+    auto y = Qin<double>::make(4.0);
+    std::shared_ptr<Qin<double>> len = Qin<double, Hypot>::make(x, y);
+
+    ASSERT_F(len->get(), 5.0);
+    *x = 6.0;
+    *y = 8.0;
+    ASSERT_F(len->get(), 10.0);
+
+    return 0;
+}
+
 int main() {
     auto tests = {
         // Arithmetic
@@ -303,7 +346,10 @@ int main() {
         test_complex_arithmetic_expression(),
         test_comparison_chain(),
         // API
-        test_zong_heng_accessors()
+        test_zong_heng_accessors(),
+        // Compile-time effect nodes
+        test_operator_node_type(),
+        test_operator_node_custom_functor()
     };
 
     return !std::all_of(tests.begin(), tests.end(), [](int val) {
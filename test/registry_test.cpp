@@ -0,0 +1,140 @@
+//
+// Test node ids and the node registry
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace ZongHeng;
+
+// ============================================================================
+// Ids
+// ============================================================================
+
+int test_ids_are_dense() {
+    auto& nodes = NodeRegistry::global();
+
+    auto a   = Qin<int>::make(1);
+    auto b   = Qin<int>::make(2);
+    auto sum = a + b;
+
+    ASSERT_I(static_cast<int>(b->getId()), static_cast<int>(a->getId()) + 1);
+    ASSERT_I(static_cast<int>(sum->getId()), static_cast<int>(b->getId()) + 1);
+    ASSERT_I(nodes.size() > sum->getId(), true);
+
+    ASSERT_I(nodes.get(a->getId()).get() == a.get(), true);
+    ASSERT_I(nodes.get<int>(sum->getId()).get() == sum.get(), true);
+
+    return 0;
+}
+
+int test_ids_index_flat_arrays() {
+    auto& nodes = NodeRegistry::global();
+
+    auto x = Qin<int>::make(3);
+    auto y = x->map([](int v) { return v * 2; });
+
+    std::vector<int> depth(nodes.size(), 0);
+    depth[y->getId()] = depth[x->getId()] + 1;
+    ASSERT_I(depth[y->getId()], 1);
+
+    return 0;
+}
+
+int test_destroyed_node_leaves_gap() {
+    auto& nodes = NodeRegistry::global();
+
+    uint32_t id;
+    {
+        Yi<int, int> local(5); // not made through make(): destroyed at scope exit
+        id = local.getId();
+    }
+
+    ASSERT_I(nodes.get(id).get() == nullptr, true);
+    ASSERT_I(nodes.get<int>(id).get() == nullptr, true);
+
+    auto next = Qin<int>::make(0);
+    ASSERT_I(next->getId() > id, true); // ids are never reused
+
+    return 0;
+}
+
+// ============================================================================
+// Names
+// ============================================================================
+
+int test_find_by_name() {
+    auto& nodes = NodeRegistry::global();
+
+    auto price = Qin<double>::make(9.5);
+    nodes.name(price, "price");
+
+    auto found = nodes.find<double>("price");
+    ASSERT_I(found.get() == price.get(), true);
+    ASSERT_F(found->get(), 9.5);
+    ASSERT_S(std::string(nodes.nameOf(price->getId())), std::string("price"));
+
+    ASSERT_I(nodes.find("missing").get() == nullptr, true);
+    ASSERT_I(nodes.find<double>("missing").get() == nullptr, true);
+
+    return 0;
+}
+
+int test_typed_lookup_checks_type() {
+    auto& nodes = NodeRegistry::global();
+
+    auto flag = Qin<bool>::make(true);
+    nodes.name(flag, "flag");
+
+    try {
+        nodes.find<int>("flag");
+    } catch (const std::runtime_error&) {
+        return 0;
+    }
+
+    printf("%s: expected runtime_error\n", __func__);
+    return -1;
+}
+
+int test_names_are_unique() {
+    auto& nodes = NodeRegistry::global();
+
+    auto first  = Qin<int>::make(1);
+    auto second = Qin<int>::make(2);
+    nodes.name(first, "unique");
+    nodes.name(first, "unique"); // same node: no-op
+
+    try {
+        nodes.name(second, "unique");
+    } catch (const std::runtime_error&) {
+        nodes.name(first, "renamed"); // frees the old name
+        nodes.name(second, "unique");
+        ASSERT_I(nodes.find<int>("unique").get() == second.get(), true);
+        ASSERT_I(nodes.find<int>("renamed").get() == first.get(), true);
+        return 0;
+    }
+
+    printf("%s: expected runtime_error\n", __func__);
+    return -1;
+}
+
+int main() {
+    auto tests = {
+        // ids
+        test_ids_are_dense(),
+        test_ids_index_flat_arrays(),
+        test_destroyed_node_leaves_gap(),
+        // names
+        test_find_by_name(),
+        test_typed_lookup_checks_type(),
+        test_names_are_unique()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
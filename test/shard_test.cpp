@@ -0,0 +1,251 @@
+//
+// Test ShardedGraph: partitioning, epochs across threads, restore
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+using namespace ZongHeng;
+
+using Node = std::shared_ptr<Qin<int>>;
+
+// ============================================================================
+// Partitioning
+// ============================================================================
+
+int test_shard_components() {
+    std::vector<Node> sources, totals;
+    for (int i = 0; i < 8; ++i) {
+        sources.push_back(Qin<int>::make(i));
+        totals.push_back(sources[i] + sources[i] * constant(10));
+    }
+    std::vector<QinBase::Observation> watches;
+    for (auto& total : totals) {
+        watches.push_back(total->observe());
+    }
+
+    std::vector<QinBase::SharedQinBase_T> roots(totals.begin(), totals.end());
+    auto sharded = shard(roots, { 4 });
+    auto stats   = sharded->getStats();
+
+    ASSERT_I(static_cast<int>(stats.shards), 4);
+    ASSERT_I(static_cast<int>(stats.nodes), 16);
+    ASSERT_I(static_cast<int>(stats.rounds), 1); // components are never split
+    for (auto count : stats.shardNodes) {
+        ASSERT_I(static_cast<int>(count), 4);
+    }
+    for (int i = 0; i < 8; ++i) {
+        *sources[i] = i + 1;
+    }
+    ASSERT_I(totals[0]->get(), 0); // queued until the epoch
+    sharded->run();
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_I(totals[i]->get(), (i + 1) * 11);
+    }
+    ASSERT_I(static_cast<int>(sharded->getStats().epochs), 1);
+
+    return 0;
+}
+
+int test_shard_hints_across_shards() {
+    auto a = Qin<int>::make(1);
+    auto x = a + a;
+    auto y = x * constant(3);
+    auto z = y + x;
+    auto watch = z->observe();
+
+    ShardedGraph::Options options;
+    options.shards = 2;
+    options.hints  = { { x, 0 }, { y, 1 }, { z, 0 } };
+    auto sharded   = shard({ z }, options);
+
+    ASSERT_I(static_cast<int>(sharded->shardOfNode(y)), 1);
+    ASSERT_I(static_cast<int>(sharded->shardOfNode(z)), 0);
+    ASSERT_I(static_cast<int>(sharded->getStats().rounds), 3); // x, then y, then z
+
+    std::vector<int> seen;
+    auto sub = z->subscribe([&seen](int v) { seen.push_back(v); });
+
+    *a = 5;
+    sharded->run();
+    ASSERT_I(x->get(), 10);
+    ASSERT_I(y->get(), 30);
+    ASSERT_I(z->get(), 40);
+    ASSERT_I(static_cast<int>(seen.size()), 1); // no intermediate value of z
+    ASSERT_I(seen[0], 40);
+
+    return 0;
+}
+
+int test_shard_bad_graphs() {
+    auto a    = Qin<int>::make(1);
+    auto b    = Qin<int>::make(2);
+    auto both = computed([a, b]() { return a->get() + b->get(); });
+    try {
+        shard({ both }, { 2 });
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+
+    auto sum = a + b;
+    ShardedGraph::Options options;
+    options.shards = 2;
+    options.hints  = { { sum, 5 } };
+    try {
+        shard({ sum }, options);
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+    ASSERT_I(static_cast<int>(a->getHengCount()), 2); // nothing was cut
+
+    return 0;
+}
+
+// ============================================================================
+// Epochs
+// ============================================================================
+
+int test_shard_conflates_writes() {
+    auto a     = Qin<int>::make(0);
+    int  calls = 0;
+    auto view  = a->map([&calls](int v) {
+        ++calls;
+        return v * 2;
+    });
+    auto watch   = view->observe();
+    auto sharded = shard({ view }, { 2 });
+
+    calls = 0;
+    for (int i = 1; i <= 50; ++i) {
+        *a = i;
+    }
+    sharded->run();
+    ASSERT_I(calls, 1);
+    ASSERT_I(view->get(), 100);
+
+    sharded->run(); // nothing queued: no epoch
+    ASSERT_I(static_cast<int>(sharded->getStats().epochs), 1);
+
+    return 0;
+}
+
+int test_shard_cold_consumer() {
+    auto a = Qin<int>::make(1);
+    auto x = a + a;
+    auto y = x + constant(1); // never observed
+
+    ShardedGraph::Options options;
+    options.shards = 2;
+    options.hints  = { { x, 0 }, { y, 1 } };
+    auto sharded   = shard({ y }, options);
+
+    *a = 4;
+    sharded->run();
+    ASSERT_I(y->isDirty(), true);
+    ASSERT_I(y->get(), 9);
+
+    return 0;
+}
+
+int test_shard_restores_edges() {
+    auto a   = Qin<int>::make(1);
+    auto sum = a + a;
+    {
+        auto sharded = shard({ sum }, { 2 });
+        ASSERT_I(static_cast<int>(a->getHengCount()), 0);
+        try {
+            sum->dispose();
+            return 1;
+        } catch (const std::runtime_error&) {
+        }
+        *a = 3; // flushed when the graph goes away
+    }
+    ASSERT_I(sum->get(), 6);
+    ASSERT_I(static_cast<int>(a->getHengCount()), 1);
+
+    *a = 7; // synchronous again
+    ASSERT_I(sum->get(), 14);
+
+    return 0;
+}
+
+// ============================================================================
+// Against an unsharded graph
+// ============================================================================
+
+// Layered random graph over `sources`; same seed gives the same shape
+std::vector<Node> buildLayers(const std::vector<Node>& sources, uint32_t seed) {
+    std::vector<Node> nodes(sources);
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+    for (int i = 0; i < 120; ++i) {
+        auto& lhs = nodes[next() % nodes.size()];
+        auto& rhs = nodes[next() % nodes.size()];
+        switch (next() % 3) {
+            case 0: nodes.push_back(lhs + rhs); break;
+            case 1: nodes.push_back(lhs - rhs); break;
+            default: nodes.push_back(lhs ^ rhs); break;
+        }
+    }
+    return nodes;
+}
+
+int test_shard_matches_reference() {
+    std::vector<Node> sharedSrc, plainSrc;
+    for (int i = 0; i < 6; ++i) {
+        sharedSrc.push_back(Qin<int>::make(i));
+        plainSrc.push_back(Qin<int>::make(i));
+    }
+    auto sharded = buildLayers(sharedSrc, 7);
+    auto plain   = buildLayers(plainSrc, 7);
+
+    std::vector<QinBase::Observation> watches;
+    for (size_t i = 6; i < sharded.size(); i += 3) {
+        watches.push_back(sharded[i]->observe());
+        watches.push_back(plain[i]->observe());
+    }
+
+    std::vector<QinBase::SharedQinBase_T> roots(sharded.begin() + 6, sharded.end());
+    auto graph = shard(roots, { 4 });
+
+    uint32_t seed = 99;
+    for (int epoch = 0; epoch < 20; ++epoch) {
+        for (int w = 0; w < 3; ++w) {
+            seed = seed * 1664525u + 1013904223u;
+            int source = static_cast<int>((seed >> 8) % 6);
+            int value  = static_cast<int>(seed >> 20);
+            *sharedSrc[source] = value;
+            *plainSrc[source]  = value;
+        }
+        graph->run();
+        for (size_t i = 0; i < sharded.size(); ++i) {
+            ASSERT_I(sharded[i]->get(), plain[i]->get());
+        }
+    }
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // partitioning
+        test_shard_components(),
+        test_shard_hints_across_shards(),
+        test_shard_bad_graphs(),
+        // epochs
+        test_shard_conflates_writes(),
+        test_shard_cold_consumer(),
+        test_shard_restores_edges(),
+        // against an unsharded graph
+        test_shard_matches_reference()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
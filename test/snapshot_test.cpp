@@ -0,0 +1,210 @@
+//
+// Test graph snapshots (save / mmap load)
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace ZongHeng;
+
+static const std::string kPath = "snapshot_test.zhs";
+
+static int scaleCalls = 0;
+
+static void defineBuilders() {
+    Snapshot::define("scale", [](const Snapshot::Args& in) {
+        return Snapshot::arg<int>(in, 0)->map([](int x) {
+            ++scaleCalls;
+            return x * 10;
+        });
+    });
+}
+
+// ============================================================================
+// Round Trip
+// ============================================================================
+
+int test_snapshot_builtin_operators() {
+    auto a = Qin<int>::make(6);
+    auto b = Qin<int>::make(4);
+    auto sum     = a + b;
+    auto product = sum * a;
+    auto less    = a < b;
+    auto neg     = -b;
+    ASSERT_I(product->get(), 60); // bring the cold nodes up to date
+
+    Snapshot::save(kPath, { product, less, neg });
+    auto graph = Snapshot::load(kPath);
+
+    ASSERT_I(static_cast<int>(graph.nodes.size()), 6);
+    ASSERT_I(static_cast<int>(graph.roots.size()), 3);
+
+    auto rProduct = graph.roots[0]->into<int, int>();
+    auto rLess    = graph.roots[1]->into<bool, bool>();
+    auto rNeg     = graph.roots[2]->into<int, int>();
+
+    ASSERT_I(rProduct->isDirty(), false); // values restored, not recomputed
+    ASSERT_I(rProduct->get(), 60);
+    ASSERT_I(rLess->get(), false);
+    ASSERT_I(rNeg->get(), -4);
+
+    ASSERT_I(graph.nodes[0]->getKind() == NodeKind::Source, true);
+    ASSERT_I(graph.roots[0]->getKind() == NodeKind::Mul, true);
+
+    return 0;
+}
+
+int test_snapshot_restored_graph_is_live() {
+    auto a = Qin<double>::make(1.5);
+    auto b = Qin<double>::make(2.0);
+    auto ratio = a / b;
+
+    Snapshot::save(kPath, { ratio });
+    auto graph = Snapshot::load(kPath);
+
+    auto rA     = graph.nodes[0]->into<double, double>();
+    auto rRatio = graph.roots[0]->into<double, double>();
+    ASSERT_F(rRatio->get(), 0.75);
+
+    *rA = 3.0;
+    ASSERT_F(rRatio->get(), 1.5);
+    ASSERT_F(ratio->get(), 0.75); // original graph untouched
+
+    return 0;
+}
+
+int test_snapshot_shared_operand() {
+    auto x      = Qin<int>::make(7);
+    auto square = x * x; // linked once, rebuilt with both operands
+
+    Snapshot::save(kPath, { square });
+    auto graph = Snapshot::load(kPath);
+
+    ASSERT_I(static_cast<int>(graph.nodes.size()), 2);
+    auto rX      = graph.nodes[0]->into<int, int>();
+    auto rSquare = graph.roots[0]->into<int, int>();
+    *rX = 3;
+    ASSERT_I(rSquare->get(), 9);
+
+    return 0;
+}
+
+int test_snapshot_constant_operand() {
+    auto x      = Qin<int>::make(2);
+    auto scaled = x * constant(5);
+
+    Snapshot::save(kPath, { scaled });
+    auto graph = Snapshot::load(kPath);
+
+    ASSERT_I(static_cast<int>(graph.nodes.size()), 3);
+    auto rX      = graph.nodes[0]->into<int, int>();
+    auto rScaled = graph.roots[0]->into<int, int>();
+    ASSERT_I(graph.nodes[1]->isConstant(), true); // still a scalar operand
+    ASSERT_I(static_cast<int>(graph.nodes[1]->getHengCount()), 0);
+    *rX = 4;
+    ASSERT_I(rScaled->get(), 20);
+
+    return 0;
+}
+
+// ============================================================================
+// Named Builders
+// ============================================================================
+
+int test_snapshot_named_builder() {
+    auto price  = Qin<int>::make(3);
+    auto scaled = Snapshot::build<int>("scale", { price });
+    auto total  = scaled + price;
+    ASSERT_I(total->get(), 33);
+
+    Snapshot::save(kPath, { total });
+
+    scaleCalls = 0;
+    auto graph = Snapshot::load(kPath);
+    auto rTotal = graph.roots[0]->into<int, int>();
+    ASSERT_I(rTotal->get(), 33);
+    ASSERT_I(scaleCalls, 0); // builder re-bound, value taken from the file
+
+    *graph.nodes[0]->into<int, int>() = 5;
+    ASSERT_I(rTotal->get(), 55);
+
+    return 0;
+}
+
+int test_snapshot_rejects_anonymous_lambda() {
+    auto a       = Qin<int>::make(1);
+    auto doubled = a->map([](int x) { return x * 2; });
+
+    try {
+        Snapshot::save(kPath, { doubled });
+    } catch (const std::runtime_error&) {
+        return 0;
+    }
+
+    printf("%s: expected runtime_error\n", __func__);
+    return -1;
+}
+
+// ============================================================================
+// Bindings and Corruption
+// ============================================================================
+
+int test_snapshot_bindings() {
+    auto source = Qin<int>::make(1);
+    auto mirror = Qin<int>::make(1);
+    mirror << source;
+
+    Snapshot::save(kPath, { source, mirror });
+    auto graph = Snapshot::load(kPath);
+
+    auto rSource = graph.roots[0]->into<int, int>();
+    auto rMirror = graph.roots[1]->into<int, int>();
+    *rSource = 42;
+    ASSERT_I(rMirror->get(), 42);
+
+    return 0;
+}
+
+int test_snapshot_corrupt_file() {
+    {
+        std::ofstream out(kPath, std::ios::binary | std::ios::trunc);
+        out << "definitely not a snapshot, but long enough to hold a header......";
+    }
+
+    try {
+        Snapshot::load(kPath);
+    } catch (const std::runtime_error&) {
+        return 0;
+    }
+
+    printf("%s: expected runtime_error\n", __func__);
+    return -1;
+}
+
+int main() {
+    defineBuilders();
+
+    auto tests = {
+        // round trip
+        test_snapshot_builtin_operators(),
+        test_snapshot_restored_graph_is_live(),
+        test_snapshot_shared_operand(),
+        test_snapshot_constant_operand(),
+        // named builders
+        test_snapshot_named_builder(),
+        test_snapshot_rejects_anonymous_lambda(),
+        // bindings and corruption
+        test_snapshot_bindings(),
+        test_snapshot_corrupt_file()
+    };
+
+    std::remove(kPath.c_str());
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
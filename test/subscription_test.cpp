@@ -0,0 +1,176 @@
+//
+// Test subscribe() and batched notification delivery
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace ZongHeng;
+
+// ============================================================================
+// Delivery
+// ============================================================================
+
+int test_subscribe_basic() {
+    auto a = Qin<int>::make(1);
+    auto b = Qin<int>::make(2);
+    auto sum = a + b;
+
+    std::vector<int> seen;
+    auto sub = sum->subscribe([&seen](int v) { seen.push_back(v); });
+
+    ASSERT_I(sum->isHot(), true);
+    ASSERT_I(static_cast<int>(seen.size()), 0); // no call on subscribe
+
+    *a = 10;
+    *b = 20;
+    ASSERT_I(static_cast<int>(seen.size()), 2);
+    ASSERT_I(seen[0], 12);
+    ASSERT_I(seen[1], 30);
+
+    return 0;
+}
+
+int test_diamond_no_glitch() {
+    auto a     = Qin<int>::make(1);
+    auto left  = a->map([](int x) { return x + 1; });
+    auto right = a->map([](int x) { return x * 2; });
+    auto both  = left + right;
+
+    std::vector<int> seen;
+    auto sub = both->subscribe([&seen](int v) { seen.push_back(v); });
+
+    *a = 10; // both recomputes twice during the pass
+    ASSERT_I(static_cast<int>(seen.size()), 1);
+    ASSERT_I(seen[0], 31);
+
+    return 0;
+}
+
+int test_explicit_batch() {
+    auto bid    = Qin<int>::make(100);
+    auto ask    = Qin<int>::make(101);
+    auto spread = ask - bid;
+
+    std::vector<int> seen;
+    auto sub = spread->subscribe([&seen](int v) { seen.push_back(v); });
+
+    {
+        Batch batch;
+        *bid = 200;
+        *ask = 205;
+        ASSERT_I(static_cast<int>(seen.size()), 0); // still inside the pass
+    }
+
+    ASSERT_I(static_cast<int>(seen.size()), 1);
+    ASSERT_I(seen[0], 5);
+
+    return 0;
+}
+
+int test_unchanged_value_skipped() {
+    auto x      = Qin<int>::make(3);
+    auto parity = x->map([](int v) { return v % 2; });
+
+    int  calls = 0;
+    auto sub   = parity->subscribe([&calls](int) { ++calls; });
+
+    *x = 5; // still odd
+    ASSERT_I(calls, 0);
+
+    *x = 6;
+    ASSERT_I(calls, 1);
+
+    return 0;
+}
+
+// ============================================================================
+// Lifetime
+// ============================================================================
+
+int test_subscription_raii() {
+    auto a       = Qin<int>::make(1);
+    auto doubled = a->map([](int x) { return x * 2; });
+
+    int calls = 0;
+    {
+        auto sub = doubled->subscribe([&calls](int) { ++calls; });
+        *a = 2;
+        ASSERT_I(calls, 1);
+        ASSERT_I(static_cast<int>(doubled->getSubscriberCount()), 1);
+    }
+
+    ASSERT_I(static_cast<int>(doubled->getSubscriberCount()), 0);
+    ASSERT_I(doubled->isHot(), false);
+
+    *a = 3;
+    ASSERT_I(calls, 1);
+
+    return 0;
+}
+
+// ============================================================================
+// Executors and re-entrancy
+// ============================================================================
+
+int test_executor_defers_delivery() {
+    auto name     = Qin<std::string>::make("a");
+    auto greeting = Qin<std::string>::make("hi ") + name;
+
+    std::vector<std::function<void()>> queue;
+    std::vector<std::string>           seen;
+
+    auto sub = greeting->subscribe(
+        [&seen](const std::string& v) { seen.push_back(v); },
+        [&queue](std::function<void()> task) { queue.push_back(std::move(task)); });
+
+    *name = std::string("b");
+    *name = std::string("c");
+    ASSERT_I(static_cast<int>(seen.size()), 0);
+    ASSERT_I(static_cast<int>(queue.size()), 2);
+
+    for (auto& task : queue) task();
+    ASSERT_S(seen[0], std::string("hi b")); // value captured at the end of its pass
+    ASSERT_S(seen[1], std::string("hi c"));
+
+    return 0;
+}
+
+int test_callback_writes_other_node() {
+    auto input  = Qin<int>::make(0);
+    auto mirror = Qin<int>::make(0);
+    auto echo   = mirror->map([](int x) { return x + 1; });
+
+    std::vector<int> seen;
+    auto s1 = input->subscribe([mirror](int v) { *mirror = v * 10; });
+    auto s2 = echo->subscribe([&seen](int v) { seen.push_back(v); });
+
+    *input = 4;
+    ASSERT_I(static_cast<int>(seen.size()), 1);
+    ASSERT_I(seen[0], 41);
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // delivery
+        test_subscribe_basic(),
+        test_diamond_no_glitch(),
+        test_explicit_batch(),
+        test_unchanged_value_skipped(),
+        // lifetime
+        test_subscription_raii(),
+        // executors
+        test_executor_defers_delivery(),
+        test_callback_writes_other_node()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
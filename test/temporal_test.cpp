@@ -0,0 +1,224 @@
+//
+// Test time-based combinators (throttle, debounce, sample) and the timer wheel
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace ZongHeng;
+using std::chrono::milliseconds;
+
+// ============================================================================
+// TimerWheel Tests
+// ============================================================================
+
+int test_wheel_fires_in_order() {
+    auto clock = std::make_shared<ManualClock>();
+    Scheduler sched(clock);
+
+    std::vector<int> fired;
+    sched.scheduleAfter(milliseconds(30), [&fired]() { fired.push_back(3); });
+    sched.scheduleAfter(milliseconds(10), [&fired]() { fired.push_back(1); });
+    sched.scheduleAfter(milliseconds(20), [&fired]() { fired.push_back(2); });
+
+    clock->advance(milliseconds(15));
+    ASSERT_I(static_cast<int>(sched.poll()), 1);
+
+    clock->advance(milliseconds(100));
+    ASSERT_I(static_cast<int>(sched.poll()), 2);
+
+    ASSERT_I(static_cast<int>(fired.size()), 3);
+    ASSERT_I(fired[0], 1);
+    ASSERT_I(fired[1], 2);
+    ASSERT_I(fired[2], 3);
+
+    return 0;
+}
+
+int test_wheel_cancel() {
+    auto clock = std::make_shared<ManualClock>();
+    Scheduler sched(clock);
+
+    int  count = 0;
+    auto id    = sched.scheduleAfter(milliseconds(5), [&count]() { ++count; });
+
+    ASSERT_I(sched.cancel(id), true);
+    ASSERT_I(sched.cancel(id), false);
+
+    clock->advance(milliseconds(10));
+    sched.poll();
+    ASSERT_I(count, 0);
+
+    return 0;
+}
+
+int test_wheel_multiple_revolutions() {
+    auto clock = std::make_shared<ManualClock>();
+    Scheduler sched(clock, milliseconds(1), 8);
+
+    int count = 0;
+    sched.scheduleAfter(milliseconds(20), [&count]() { ++count; });
+
+    // Bucket of tick 20 is visited at tick 4 and 12 without firing
+    clock->advance(milliseconds(12));
+    sched.poll();
+    ASSERT_I(count, 0);
+
+    clock->advance(milliseconds(8));
+    sched.poll();
+    ASSERT_I(count, 1);
+
+    return 0;
+}
+
+// ============================================================================
+// throttle Tests
+// ============================================================================
+
+int test_throttle_leading_and_trailing() {
+    auto clock = std::make_shared<ManualClock>();
+    auto sched = std::make_shared<Scheduler>(clock);
+
+    auto ticks = Qin<int>::make(0);
+    auto slow  = ticks->throttle(milliseconds(100), sched);
+
+    int  recomputes = 0;
+    auto expensive  = slow->map([&recomputes](int x) {
+        ++recomputes;
+        return x * 2;
+    });
+    ASSERT_I(expensive->get(), 0);
+
+    *ticks = 1; // leading edge goes straight through
+    ASSERT_I(slow->get(), 1);
+
+    *ticks = 2;
+    *ticks = 3;
+    *ticks = 4;
+    ASSERT_I(slow->get(), 1); // held back inside the interval
+
+    clock->advance(milliseconds(100));
+    sched->poll();
+    ASSERT_I(slow->get(), 4); // trailing edge carries the latest value
+    ASSERT_I(expensive->get(), 8);
+
+    return 0;
+}
+
+int test_throttle_bounded_rate() {
+    auto clock = std::make_shared<ManualClock>();
+    auto sched = std::make_shared<Scheduler>(clock);
+
+    auto ticks   = Qin<int>::make(0);
+    auto slow    = ticks->throttle(milliseconds(10), sched);
+    int  updates = 0;
+    auto tap     = slow->map([&updates](int x) {
+        ++updates;
+        return x;
+    });
+
+    // 1000 writes over 100ms -> at most one update per 10ms window
+    for (int i = 1; i <= 1000; ++i) {
+        *ticks = i;
+        if (i % 10 == 0) {
+            clock->advance(milliseconds(1));
+            sched->poll();
+        }
+    }
+    clock->advance(milliseconds(10));
+    sched->poll();
+
+    ASSERT_I(slow->get(), 1000);
+    if (updates > 12) {
+        printf("throttle forwarded %d updates\n", updates);
+        return -1;
+    }
+
+    return 0;
+}
+
+// ============================================================================
+// debounce Tests
+// ============================================================================
+
+int test_debounce_burst() {
+    auto clock = std::make_shared<ManualClock>();
+    auto sched = std::make_shared<Scheduler>(clock);
+
+    auto input   = Qin<int>::make(0);
+    auto settled = input->debounce(milliseconds(50), sched);
+
+    *input = 1;
+    clock->advance(milliseconds(30));
+    sched->poll();
+    *input = 2;
+    clock->advance(milliseconds(30));
+    sched->poll();
+    ASSERT_I(settled->get(), 0); // burst still in progress
+
+    clock->advance(milliseconds(20));
+    sched->poll();
+    ASSERT_I(settled->get(), 2);
+    ASSERT_I(static_cast<int>(sched->pending()), 0);
+
+    return 0;
+}
+
+// ============================================================================
+// sample Tests
+// ============================================================================
+
+int test_sample_on_trigger() {
+    auto price = Qin<double>::make(1.0);
+    auto frame = Qin<int>::make(0);
+    auto shown = price->sample(frame);
+
+    ASSERT_F(shown->get(), 1.0);
+
+    *price = 2.0;
+    *price = 3.0;
+    ASSERT_F(shown->get(), 1.0); // no frame yet
+
+    *frame = 1;
+    ASSERT_F(shown->get(), 3.0);
+
+    return 0;
+}
+
+int test_sample_chained() {
+    auto price = Qin<int>::make(10);
+    auto frame = Qin<bool>::make(false);
+
+    auto doubled = price->sample(frame)->map([](int x) { return x * 2; });
+    ASSERT_I(doubled->get(), 20);
+
+    *price = 21;
+    *frame = true;
+    ASSERT_I(doubled->get(), 42);
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // timer wheel
+        test_wheel_fires_in_order(),
+        test_wheel_cancel(),
+        test_wheel_multiple_revolutions(),
+        // throttle
+        test_throttle_leading_and_trailing(),
+        test_throttle_bounded_rate(),
+        // debounce
+        test_debounce_burst(),
+        // sample
+        test_sample_on_trigger(),
+        test_sample_chained()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
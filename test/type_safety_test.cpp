@@ -71,14 +71,15 @@ int test_convert_valid() {
 
 // Test 5: convert() with non-convertible types should throw
 int test_convert_invalid() {
-    try {
-        // vector<int> -> int is not convertible
-        std::vector<int> vec = {1, 2, 3};
-        int result = convert<std::vector<int>, int>(vec);
-        return 1; // Should not reach
-    } catch (const std::runtime_error&) {
-        return 0; // Expected
-    }
+    // vector<int> -> int is not convertible: convert() is rejected at compile time
+    ASSERT_I((is_convertible_value_v<std::vector<int>, int>), false);
+    ASSERT_I((is_convertible_value_v<double, int>), true);
+
+    // A Yi over such a pair is usable once it has hooks
+    auto sizes = Yi<std::vector<int>, int>::make(std::vector<int>{1, 2, 3});
+    sizes->getter([](const std::vector<int>& v) { return static_cast<int>(v.size()); });
+    ASSERT_I(sizes->get(), 3);
+    return 0;
 }
 
 // Test 6: set() type propagation with mixed types in Zong/Heng
@@ -205,6 +206,35 @@ int test_virtual_destructor() {
     return 0;
 }
 
+// Test 13: into_ref() returns the node itself, without touching the refcount
+int test_into_ref_same_object() {
+    std::shared_ptr<QinBase> base = Qin<int>::make(7);
+    auto uses = base.use_count();
+
+    auto& ref = base->into_ref<int, int>();
+    ASSERT_I(&ref == base.get(), true);
+    ASSERT_I(ref.get(), 7);
+    ASSERT_I(static_cast<int>(base.use_count()), static_cast<int>(uses));
+
+    ASSERT_I((base->isA<int, int>()), true);
+    ASSERT_I((base->isA<int, double>()), false);
+
+    return 0;
+}
+
+// Test 14: into_ref() with incorrect type throws like into()
+int test_into_ref_incorrect_type() {
+    auto yi = Yi<std::string, int>::make("Hello");
+
+    try {
+        yi->into_ref<int, std::string>();
+        return 1; // Should not reach
+    } catch (const std::runtime_error& e) {
+        std::string msg = e.what();
+        return msg.find("Type mismatch in into_ref()") == std::string::npos;
+    }
+}
+
 int main() {
     auto tests = {
         test_into_correct_type(),
@@ -218,7 +248,9 @@ int main() {
         test_qin_type_safety(),
         test_lian_type_matching(),
         test_lian_type_mismatch(),
-        test_virtual_destructor()
+        test_virtual_destructor(),
+        test_into_ref_same_object(),
+        test_into_ref_incorrect_type()
     };
 
     return !std::all_of(tests.begin(), tests.end(), [](int val) {
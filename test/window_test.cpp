@@ -0,0 +1,161 @@
+//
+// Test windowed streaming aggregations (window, windowTime)
+//
+
+#include "ZongHeng.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+
+using namespace ZongHeng;
+using std::chrono::milliseconds;
+
+// ============================================================================
+// RingBuffer / RollingWindow Tests
+// ============================================================================
+
+int test_ring_buffer_wraps() {
+    RingBuffer<int> ring(3);
+
+    ring.push_back(1);
+    ring.push_back(2);
+    ring.push_back(3);
+    ring.pop_front();
+    ring.push_back(4); // wraps into slot 0
+
+    ASSERT_I(static_cast<int>(ring.capacity()), 3);
+    ASSERT_I(ring.front(), 2);
+    ASSERT_I(ring.back(), 4);
+    ASSERT_I(ring[1], 3);
+
+    ring.push_back(5); // full -> grows, order preserved
+    ASSERT_I(static_cast<int>(ring.size()), 4);
+    ASSERT_I(ring.front(), 2);
+    ASSERT_I(ring.back(), 5);
+
+    return 0;
+}
+
+int test_rolling_matches_brute_force() {
+    const size_t          n = 5;
+    RollingWindow<double> window(n);
+    std::deque<double>    ref;
+
+    double xs[] = { 3, -1, 4, 1, -5, 9, 2, 6, 5, 3, 5, -8, 9, 7, 9 };
+    for (double x : xs) {
+        if (window.size() == n) {
+            window.pop();
+            ref.pop_front();
+        }
+        window.push(x);
+        ref.push_back(x);
+
+        double sum = 0;
+        for (double v : ref) sum += v;
+        double mean = sum / ref.size();
+        double var  = 0;
+        for (double v : ref) var += (v - mean) * (v - mean);
+        var /= ref.size();
+
+        auto s = window.stats();
+        ASSERT_I(static_cast<int>(s.count), static_cast<int>(ref.size()));
+        ASSERT_F(s.sum, sum);
+        ASSERT_F(s.min, *std::min_element(ref.begin(), ref.end()));
+        ASSERT_F(s.max, *std::max_element(ref.begin(), ref.end()));
+        if (std::fabs(s.mean - mean) > 1e-9 || std::fabs(s.variance - var) > 1e-9) {
+            printf("mean %f/%f variance %f/%f\n", s.mean, mean, s.variance, var);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+// ============================================================================
+// window Tests
+// ============================================================================
+
+int test_window_count() {
+    auto price = Qin<double>::make(1.0);
+    auto stats = price->window(3);
+
+    ASSERT_I(static_cast<int>(stats->get().count), 1);
+
+    *price = 2.0;
+    *price = 3.0;
+    ASSERT_F(stats->get().sum, 6.0);
+    ASSERT_F(stats->get().mean, 2.0);
+
+    *price = 10.0; // 1.0 leaves the window
+    ASSERT_I(static_cast<int>(stats->get().count), 3);
+    ASSERT_F(stats->get().sum, 15.0);
+    ASSERT_F(stats->get().min, 2.0);
+    ASSERT_F(stats->get().max, 10.0);
+
+    return 0;
+}
+
+int test_window_chained() {
+    auto price = Qin<int>::make(4);
+    auto mean  = price->window(2)->map([](const WindowStats<int>& s) { return s.mean; });
+
+    ASSERT_F(mean->get(), 4.0);
+
+    *price = 8;
+    ASSERT_F(mean->get(), 6.0);
+
+    *price = 2;
+    ASSERT_F(mean->get(), 5.0);
+
+    return 0;
+}
+
+// ============================================================================
+// windowTime Tests
+// ============================================================================
+
+int test_window_time_expiry() {
+    auto clock = std::make_shared<ManualClock>();
+    auto sched = std::make_shared<Scheduler>(clock);
+
+    auto ticks  = Qin<int>::make(1);
+    auto recent = ticks->windowTime(milliseconds(100), sched, 2);
+
+    clock->advance(milliseconds(40));
+    *ticks = 2;
+    clock->advance(milliseconds(40));
+    *ticks = 3; // ring buffer grows past the hint
+    ASSERT_I(recent->get().sum, 6);
+
+    clock->advance(milliseconds(30)); // t=110: first sample expired
+    *ticks = 4;
+    ASSERT_I(static_cast<int>(recent->get().count), 3);
+    ASSERT_I(recent->get().sum, 9);
+    ASSERT_I(recent->get().min, 2);
+
+    // Quiet source: the expiry timer keeps draining the window
+    clock->advance(milliseconds(200));
+    sched->poll();
+    ASSERT_I(static_cast<int>(recent->get().count), 0);
+
+    return 0;
+}
+
+int main() {
+    auto tests = {
+        // storage
+        test_ring_buffer_wraps(),
+        test_rolling_matches_brute_force(),
+        // window
+        test_window_count(),
+        test_window_chained(),
+        // windowTime
+        test_window_time_expiry()
+    };
+
+    return !std::all_of(tests.begin(), tests.end(), [](int val) {
+        return !val;
+    });
+}
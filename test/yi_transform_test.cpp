@@ -262,6 +262,63 @@ int test_yi_transform_pipeline() {
     return 0;
 }
 
+// Test getter results are cached until the stored value changes
+int test_yi_getter_cached() {
+    int  joins = 0;
+    auto words = Yi<std::vector<std::string>, std::string>::make(std::vector<std::string> { "a", "b" });
+    words->getter([&joins](const std::vector<std::string>& vec) {
+        ++joins;
+        std::string result;
+        for (const auto& w : vec) result += w;
+        return result;
+    });
+
+    ASSERT_S(words->get(), std::string("ab"));
+    ASSERT_S(words->get(), std::string("ab"));
+    ASSERT_S(words->peek(), std::string("ab"));
+    ASSERT_I(joins, 1);
+
+    words->setter([](const std::string& s) {
+        std::vector<std::string> result;
+        for (char c : s) result.emplace_back(1, c);
+        return result;
+    });
+    *words = std::string("cde");
+    ASSERT_S(words->get(), std::string("cde"));
+    ASSERT_S(words->get(), std::string("cde"));
+    ASSERT_I(joins, 2);
+
+    words->getter([](const std::vector<std::string>& vec) { return std::to_string(vec.size()); });
+    ASSERT_S(words->get(), std::string("3")); // new getter, cache rebuilt
+
+    return 0;
+}
+
+// Test hooked effect nodes run their getter only when the value changes
+int test_yi_effect_getter_cached() {
+    int  formats = 0;
+    auto source  = Qin<int>::make(3);
+    auto label   = Yi<int, std::string>::make(0);
+    label->getter([&formats](const int& v) {
+        ++formats;
+        return "#" + std::to_string(v);
+    });
+    label->setter([](const std::string& s) { return std::stoi(s.substr(1)); });
+    label->setEff([source]() { return "#" + std::to_string(source->get() * 2); });
+
+    // No upstream edges: recomputed on every read, but formatted once
+    ASSERT_S(label->get(), std::string("#6"));
+    ASSERT_S(label->get(), std::string("#6"));
+    ASSERT_I(formats, 1);
+
+    *source = 5;
+    ASSERT_S(label->get(), std::string("#10"));
+    ASSERT_S(label->get(), std::string("#10"));
+    ASSERT_I(formats, 2);
+
+    return 0;
+}
+
 int main() {
     auto tests = {
         test_yi_string_to_int(),
@@ -272,7 +329,9 @@ int main() {
         test_yi_hetero_with_effect(),
         test_yi_int_to_string(),
         test_yi_double_to_bool(),
-        test_yi_transform_pipeline()
+        test_yi_transform_pipeline(),
+        test_yi_getter_cached(),
+        test_yi_effect_getter_cached()
     };
 
     return !std::all_of(tests.begin(), tests.end(), [](int val) {